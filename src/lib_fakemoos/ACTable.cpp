@@ -0,0 +1,119 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: ACTable.cpp                                          */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#include "ACTable.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Constructor
+
+ACTable::ACTable(unsigned int columns, unsigned int separation)
+{
+  m_columns    = (columns > 0) ? columns : 1;
+  m_separation = separation;
+  m_right_justify.assign(m_columns, false);
+}
+
+//---------------------------------------------------------
+// Procedure: operator<<
+
+ACTable& ACTable::operator<<(const string& str)
+{
+  string::size_type start = 0;
+  while(true) {
+    string::size_type end = str.find('|', start);
+    string cell = str.substr(start, (end == string::npos) ? string::npos : end - start);
+    string::size_type first = cell.find_first_not_of(' ');
+    string::size_type last  = cell.find_last_not_of(' ');
+    if(first == string::npos)
+      m_cells.push_back("");
+    else
+      m_cells.push_back(cell.substr(first, last - first + 1));
+    if(end == string::npos)
+      break;
+    start = end + 1;
+  }
+  return(*this);
+}
+
+//---------------------------------------------------------
+// Procedure: addHeaderLines()
+//   Purpose: Underline the row just completed with dashes. The
+//            width is taken from the widest cell in each column.
+
+void ACTable::addHeaderLines(unsigned int /*max_width*/)
+{
+  while((m_cells.size() % m_columns) != 0)
+    m_cells.push_back("");
+  m_header_rows.push_back(m_cells.size() / m_columns);
+  for(unsigned int i=0; i<m_columns; i++)
+    m_cells.push_back("");
+}
+
+//---------------------------------------------------------
+// Procedure: setColumnJustify()
+
+void ACTable::setColumnJustify(unsigned int column, string justify)
+{
+  if(column < m_columns)
+    m_right_justify[column] = (justify == "right");
+}
+
+//---------------------------------------------------------
+// Procedure: getFormattedString()
+
+string ACTable::getFormattedString() const
+{
+  vector<unsigned int> widths(m_columns, 0);
+  for(unsigned int i=0; i<m_cells.size(); i++) {
+    unsigned int col = i % m_columns;
+    if(m_cells[i].size() > widths[col])
+      widths[col] = m_cells[i].size();
+  }
+
+  string result;
+  unsigned int rows = (m_cells.size() + m_columns - 1) / m_columns;
+  unsigned int next_header = 0;
+  for(unsigned int row=0; row<rows; row++) {
+    bool dashes = false;
+    if((next_header < m_header_rows.size()) && (m_header_rows[next_header] == row)) {
+      dashes = true;
+      next_header++;
+    }
+    string line;
+    for(unsigned int col=0; col<m_columns; col++) {
+      unsigned int ix = row * m_columns + col;
+      string cell = (ix < m_cells.size()) ? m_cells[ix] : "";
+      if(dashes)
+        cell = string(widths[col], '-');
+      string pad(widths[col] - cell.size(), ' ');
+      if(col > 0)
+        line += string(m_separation, ' ');
+      line += m_right_justify[col] ? (pad + cell) : (cell + pad);
+    }
+    string::size_type last = line.find_last_not_of(' ');
+    result += (last == string::npos) ? "" : line.substr(0, last + 1);
+    result += "\n";
+  }
+  return(result);
+}
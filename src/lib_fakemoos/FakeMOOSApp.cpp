@@ -0,0 +1,423 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: FakeMOOSApp.cpp                                      */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "MOOS/libMOOS/MOOSLib.h"
+#include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
+#include "FakeMOOSBus.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Procedure: lowerStrip()
+
+static string lowerStrip(const string& str)
+{
+  string::size_type start = str.find_first_not_of(" \t");
+  if(start == string::npos)
+    return("");
+  string::size_type end = str.find_last_not_of(" \t");
+  string result = str.substr(start, end - start + 1);
+  for(unsigned int i=0; i<result.size(); i++)
+    result[i] = tolower(result[i]);
+  return(result);
+}
+
+//---------------------------------------------------------
+// Procedure: MOOSTime()
+//   Purpose: The virtual clock of the current bus, or the wall
+//            clock if no bus has been created.
+
+double MOOSTime(bool apply_time_warp)
+{
+  FakeMOOSBus* bus = FakeMOOSBus::current();
+  if(bus)
+    return(bus->now());
+  return(MOOSLocalTime(apply_time_warp));
+}
+
+//---------------------------------------------------------
+// Procedure: MOOSLocalTime()
+
+double MOOSLocalTime(bool /*apply_time_warp*/)
+{
+  chrono::system_clock::duration since = chrono::system_clock::now().time_since_epoch();
+  return(chrono::duration<double>(since).count());
+}
+
+//---------------------------------------------------------
+// CMOOSMsg Constructors
+
+CMOOSMsg::CMOOSMsg()
+{
+  m_cDataType = MOOS_DOUBLE;
+  m_dfVal     = 0;
+  m_dfTime    = -1;
+}
+
+CMOOSMsg::CMOOSMsg(const string& key, const string& sval, double time)
+{
+  m_cDataType = MOOS_STRING;
+  m_sKey      = key;
+  m_sVal      = sval;
+  m_dfVal     = 0;
+  m_dfTime    = time;
+}
+
+CMOOSMsg::CMOOSMsg(const string& key, double dval, double time)
+{
+  m_cDataType = MOOS_DOUBLE;
+  m_sKey      = key;
+  m_dfVal     = dval;
+  m_dfTime    = time;
+}
+
+CMOOSMsg::CMOOSMsg(const string& key, const unsigned char* data,
+                   unsigned int size, double time)
+{
+  m_cDataType = MOOS_BINARY_STRING;
+  m_sKey      = key;
+  m_dfVal     = size;
+  m_dfTime    = time;
+  if(data && (size > 0))
+    m_sVal.assign((const char*)(data), size);
+}
+
+//---------------------------------------------------------
+// Procedure: GetBinaryDataSize()
+
+unsigned int CMOOSMsg::GetBinaryDataSize() const
+{
+  if(!IsBinary())
+    return(0);
+  return(m_sVal.size());
+}
+
+//---------------------------------------------------------
+// Procedure: GetBinaryData()
+
+const unsigned char* CMOOSMsg::GetBinaryData() const
+{
+  if(!IsBinary())
+    return(0);
+  return((const unsigned char*)(m_sVal.data()));
+}
+
+//---------------------------------------------------------
+// Procedure: GetBinaryDataAsVector()
+
+vector<unsigned char> CMOOSMsg::GetBinaryDataAsVector() const
+{
+  if(!IsBinary())
+    return(vector<unsigned char>());
+  return(vector<unsigned char>(m_sVal.begin(), m_sVal.end()));
+}
+
+//---------------------------------------------------------
+// Procedure: Trace()
+
+void CMOOSMsg::Trace() const
+{
+  cout << m_sKey << " = ";
+  if(IsDouble())
+    cout << m_dfVal;
+  else if(IsBinary())
+    cout << "<" << m_sVal.size() << " bytes>";
+  else
+    cout << m_sVal;
+  cout << " (" << m_sSrc << " @ " << m_dfTime << ")" << endl;
+}
+
+//---------------------------------------------------------
+// Procedure: GetConfiguration()
+
+bool CProcessConfigReader::GetConfiguration(string /*app_name*/, STRING_LIST& params)
+{
+  params = m_params;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: GetValue()
+
+bool CProcessConfigReader::GetValue(string name, string& value)
+{
+  name = lowerStrip(name);
+  STRING_LIST::const_iterator p;
+  for(p=m_globals.begin(); p!=m_globals.end(); p++) {
+    string::size_type pos = p->find('=');
+    if((pos != string::npos) && (lowerStrip(p->substr(0, pos)) == name)) {
+      string rest = p->substr(pos + 1);
+      string::size_type start = rest.find_first_not_of(" \t");
+      value = (start == string::npos) ? "" : rest.substr(start);
+      return(true);
+    }
+  }
+  return(false);
+}
+
+//---------------------------------------------------------
+// Procedure: SetGlobal()
+
+void CProcessConfigReader::SetGlobal(string name, string value)
+{
+  m_globals.push_back(name + "=" + value);
+}
+
+//---------------------------------------------------------
+// CMOOSApp Constructor
+
+CMOOSApp::CMOOSApp()
+{
+  m_dfFreq = 4;
+  m_bus    = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: AttachToBus()
+
+void CMOOSApp::AttachToBus(FakeMOOSBus* bus, const string& name, double freq,
+                           const STRING_LIST& config)
+{
+  m_bus      = bus;
+  m_sAppName = name;
+  m_dfFreq   = freq;
+  m_MissionReader.SetConfiguration(config);
+}
+
+//---------------------------------------------------------
+// Procedure: Notify()
+
+bool CMOOSApp::Notify(const string& var, const string& sval, double time)
+{
+  if(!m_bus)
+    return(false);
+  CMOOSMsg msg(var, sval, time);
+  return(m_bus->publish(msg, this));
+}
+
+bool CMOOSApp::Notify(const string& var, const char* sval, double time)
+{
+  return(Notify(var, string(sval), time));
+}
+
+bool CMOOSApp::Notify(const string& var, double dval, double time)
+{
+  if(!m_bus)
+    return(false);
+  CMOOSMsg msg(var, dval, time);
+  return(m_bus->publish(msg, this));
+}
+
+bool CMOOSApp::Notify(const string& var, const vector<unsigned char>& data,
+                      double time)
+{
+  if(data.empty())
+    return(Notify(var, (void*)(0), 0, time));
+  return(Notify(var, (void*)(&data[0]), data.size(), time));
+}
+
+bool CMOOSApp::Notify(const string& var, void* data, size_t size, double time)
+{
+  if(!m_bus)
+    return(false);
+  CMOOSMsg msg(var, (const unsigned char*)(data), size, time);
+  return(m_bus->publish(msg, this));
+}
+
+//---------------------------------------------------------
+// Procedure: Register()
+
+bool CMOOSApp::Register(const string& var, double /*interval*/)
+{
+  if(!m_bus)
+    return(false);
+  return(m_bus->subscribe(this, var));
+}
+
+//---------------------------------------------------------
+// Procedure: UnRegister()
+
+bool CMOOSApp::UnRegister(const string& var)
+{
+  if(!m_bus)
+    return(false);
+  return(m_bus->unsubscribe(this, var));
+}
+
+//---------------------------------------------------------
+// AppCastingMOOSApp Constructor
+
+AppCastingMOOSApp::AppCastingMOOSApp()
+{
+  m_iteration = 0;
+  m_curr_time = 0;
+  m_last_report_time = 0;
+  m_term_report_interval = 0;
+  m_appcast_until = -1;
+  m_reports_built = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: Iterate()
+
+bool AppCastingMOOSApp::Iterate()
+{
+  m_iteration++;
+  m_curr_time = MOOSTime();
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: OnNewMail()
+//   Purpose: Handle and remove appcast requests, leaving the rest
+//            of the mail for the app.
+
+bool AppCastingMOOSApp::OnNewMail(MOOSMSG_LIST& NewMail)
+{
+  m_curr_time = MOOSTime();
+  MOOSMSG_LIST::iterator p = NewMail.begin();
+  while(p != NewMail.end()) {
+    if(p->GetKey() == "APPCAST_REQ") {
+      handleAppCastRequest(p->GetString());
+      p = NewMail.erase(p);
+    }
+    else
+      p++;
+  }
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: OnStartUp()
+
+bool AppCastingMOOSApp::OnStartUp()
+{
+  m_curr_time = MOOSTime();
+  if(!m_MissionReader.GetValue("Community", m_host_community))
+    m_host_community = "fakemoos";
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: RegisterVariables()
+
+void AppCastingMOOSApp::RegisterVariables()
+{
+  Register("APPCAST_REQ", 0);
+}
+
+//---------------------------------------------------------
+// Procedure: handleAppCastRequest()
+//   Example: node=alpha,app=pOdometry,duration=3,key=uMAC,thresh=any
+
+void AppCastingMOOSApp::handleAppCastRequest(const string& request)
+{
+  string app;
+  double duration = 3;
+
+  string::size_type start = 0;
+  while(start <= request.size()) {
+    string::size_type end = request.find(',', start);
+    if(end == string::npos)
+      end = request.size();
+    string pair = request.substr(start, end - start);
+    string::size_type pos = pair.find('=');
+    if(pos != string::npos) {
+      string param = lowerStrip(pair.substr(0, pos));
+      string value = pair.substr(pos + 1);
+      if(param == "app")
+        app = lowerStrip(value);
+      else if(param == "duration")
+        duration = atof(value.c_str());
+    }
+    start = end + 1;
+  }
+
+  if((app == "") || (app == "any") || (app == lowerStrip(GetAppName())))
+    m_appcast_until = m_curr_time + duration;
+}
+
+//---------------------------------------------------------
+// Procedure: PostReport()
+
+void AppCastingMOOSApp::PostReport(const string& /*directive*/)
+{
+  m_msgs.str("");
+  if(m_curr_time > m_appcast_until)
+    return;
+
+  buildReport();
+  m_last_report = m_msgs.str();
+  m_msgs.str("");
+  m_reports_built++;
+  m_last_report_time = m_curr_time;
+  Notify("APPCAST", m_last_report);
+}
+
+//---------------------------------------------------------
+// Procedure: reportEvent()
+
+void AppCastingMOOSApp::reportEvent(const string& str)
+{
+  char buff[32];
+  snprintf(buff, sizeof(buff), "[%.2f]: ", m_curr_time);
+  m_events.push_front(string(buff) + str);
+  if(m_events.size() > 8)
+    m_events.pop_back();
+}
+
+//---------------------------------------------------------
+// Procedure: reportConfigWarning()
+
+void AppCastingMOOSApp::reportConfigWarning(const string& str)
+{
+  m_config_warnings.push_back(str);
+}
+
+//---------------------------------------------------------
+// Procedure: reportUnhandledConfigWarning()
+
+void AppCastingMOOSApp::reportUnhandledConfigWarning(const string& str)
+{
+  m_config_warnings.push_back("Unhandled config line: " + str);
+}
+
+//---------------------------------------------------------
+// Procedure: reportRunWarning()
+
+void AppCastingMOOSApp::reportRunWarning(const string& str)
+{
+  m_run_warnings[str]++;
+}
+
+//---------------------------------------------------------
+// Procedure: retractRunWarning()
+
+void AppCastingMOOSApp::retractRunWarning(const string& str)
+{
+  m_run_warnings.erase(str);
+}
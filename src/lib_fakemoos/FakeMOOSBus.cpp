@@ -0,0 +1,372 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: FakeMOOSBus.cpp                                      */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#include <chrono>
+#include <algorithm>
+#include "FakeMOOSBus.h"
+
+using namespace std;
+
+static FakeMOOSBus* s_current_bus = 0;
+
+//---------------------------------------------------------
+// Procedure: wallNanos()
+
+static double wallNanos()
+{
+  chrono::steady_clock::duration since = chrono::steady_clock::now().time_since_epoch();
+  return(chrono::duration<double, nano>(since).count());
+}
+
+//---------------------------------------------------------
+// Procedure: zeroStats()
+
+static void zeroStats(FakeMOOSBus::AppStats& stats)
+{
+  stats.ticks      = 0;
+  stats.mail_calls = 0;
+  stats.mail_msgs  = 0;
+  stats.posts      = 0;
+  stats.post_bytes = 0;
+  stats.mail_ns    = 0;
+  stats.iterate_ns = 0;
+  stats.bus_ns     = 0;
+}
+
+//---------------------------------------------------------
+// Constructor
+
+FakeMOOSBus::FakeMOOSBus(double start_time)
+{
+  m_now       = start_time;
+  m_latency   = 0;
+  m_bus_ns    = 0;
+  m_delivered = 0;
+
+  m_prev_current = s_current_bus;
+  s_current_bus  = this;
+}
+
+//---------------------------------------------------------
+// Destructor
+
+FakeMOOSBus::~FakeMOOSBus()
+{
+  if(s_current_bus == this)
+    s_current_bus = m_prev_current;
+}
+
+//---------------------------------------------------------
+// Procedure: current()
+
+FakeMOOSBus* FakeMOOSBus::current()
+{
+  return(s_current_bus);
+}
+
+//---------------------------------------------------------
+// Procedure: addApp()
+
+bool FakeMOOSBus::addApp(CMOOSApp* app, const string& name,
+                         double app_tick, const STRING_LIST& config)
+{
+  if(!app || (app_tick <= 0) || (appIndex(app) >= 0))
+    return(false);
+
+  AppEntry entry;
+  entry.app        = app;
+  entry.name       = name;
+  entry.app_tick   = app_tick;
+  entry.tick_count = 0;
+  entry.start      = m_now;
+  zeroStats(entry.stats);
+  m_apps.push_back(entry);
+
+  app->AttachToBus(this, name, app_tick, config);
+  if(!app->OnStartUp() || !app->OnConnectToServer()) {
+    removeLastApp();
+    return(false);
+  }
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: removeLastApp()
+//   Purpose: Take back an app whose start up failed, so it is never
+//            ticked or sent mail. What it posted meanwhile stands.
+
+void FakeMOOSBus::removeLastApp()
+{
+  if(m_apps.empty())
+    return;
+
+  unsigned int ix = m_apps.size() - 1;
+  map<string, vector<unsigned int> >::iterator p;
+  for(p=m_subscribers.begin(); p!=m_subscribers.end(); p++) {
+    vector<unsigned int>& subs = p->second;
+    subs.erase(remove(subs.begin(), subs.end(), ix), subs.end());
+  }
+  m_apps.back().app->DetachFromBus();
+  m_apps.pop_back();
+}
+
+//---------------------------------------------------------
+// Procedure: poke()
+
+void FakeMOOSBus::poke(const string& var, const string& sval)
+{
+  CMOOSMsg msg(var, sval, m_now);
+  msg.m_sSrc = "uPokeDB";
+  publish(msg, 0);
+}
+
+void FakeMOOSBus::poke(const string& var, double dval)
+{
+  CMOOSMsg msg(var, dval, m_now);
+  msg.m_sSrc = "uPokeDB";
+  publish(msg, 0);
+}
+
+//---------------------------------------------------------
+// Procedure: run()
+//   Purpose: Run app ticks in time order up to now+secs. Ticks at
+//            the same time run in the order the apps were added.
+
+void FakeMOOSBus::run(double secs)
+{
+  double end_time = m_now + secs;
+  while(true) {
+    int    next_ix   = -1;
+    double next_time = 0;
+    for(unsigned int i=0; i<m_apps.size(); i++) {
+      double t = nextTick(m_apps[i]);
+      if(t > end_time)
+        continue;
+      if((next_ix < 0) || (t < next_time)) {
+        next_ix   = i;
+        next_time = t;
+      }
+    }
+    if(next_ix < 0)
+      break;
+    m_now = next_time;
+    runTick(next_ix);
+  }
+  m_now = end_time;
+}
+
+//---------------------------------------------------------
+// Procedure: runTick()
+
+void FakeMOOSBus::runTick(unsigned int ix)
+{
+  AppEntry& entry = m_apps[ix];
+  entry.tick_count++;
+  entry.stats.ticks++;
+
+  MOOSMSG_LIST mail;
+  while(!entry.mailbox.empty() && (entry.mailbox.front().due <= m_now)) {
+    mail.push_back(entry.mailbox.front().msg);
+    entry.mailbox.pop_front();
+  }
+
+  // The app's own posts are routed from inside these calls, so the
+  // bus time they take is taken back out of the app's share
+  CMOOSApp* app = entry.app;
+  if(!mail.empty()) {
+    double bus_ns0 = m_bus_ns;
+    double t0 = wallNanos();
+    app->OnNewMail(mail);
+    double t1 = wallNanos();
+    m_apps[ix].stats.mail_calls++;
+    m_apps[ix].stats.mail_msgs += mail.size();
+    m_apps[ix].stats.mail_ns += (t1 - t0) - (m_bus_ns - bus_ns0);
+  }
+
+  double bus_ns0 = m_bus_ns;
+  double t0 = wallNanos();
+  app->Iterate();
+  double t1 = wallNanos();
+  m_apps[ix].stats.iterate_ns += (t1 - t0) - (m_bus_ns - bus_ns0);
+}
+
+//---------------------------------------------------------
+// Procedure: publish()
+
+bool FakeMOOSBus::publish(CMOOSMsg& msg, const CMOOSApp* source)
+{
+  double t0 = wallNanos();
+
+  if(msg.m_dfTime < 0)
+    msg.m_dfTime = m_now;
+  int src_ix = appIndex(source);
+  if(src_ix >= 0)
+    msg.m_sSrc = m_apps[src_ix].name;
+
+  map<string, vector<unsigned int> >::const_iterator p;
+  p = m_subscribers.find(msg.m_sKey);
+  if(p != m_subscribers.end()) {
+    const vector<unsigned int>& subs = p->second;
+    for(unsigned int i=0; i<subs.size(); i++)
+      deliver(subs[i], msg, m_now + m_latency);
+  }
+  m_latest[msg.m_sKey] = msg;
+
+  double elapsed = wallNanos() - t0;
+  m_bus_ns += elapsed;
+  if(src_ix >= 0) {
+    AppStats& stats = m_apps[src_ix].stats;
+    stats.posts++;
+    stats.post_bytes += msg.m_sKey.size() + (msg.IsDouble() ? 8 : msg.m_sVal.size());
+    stats.bus_ns += elapsed;
+  }
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: deliver()
+
+void FakeMOOSBus::deliver(unsigned int ix, const CMOOSMsg& msg, double due)
+{
+  Pending pending;
+  pending.due = due;
+  pending.msg = msg;
+  m_apps[ix].mailbox.push_back(pending);
+  m_delivered++;
+}
+
+//---------------------------------------------------------
+// Procedure: subscribe()
+//   Purpose: As with the MOOSDB, a new subscriber is sent the
+//            latest value if the variable has been posted.
+
+bool FakeMOOSBus::subscribe(const CMOOSApp* app, const string& var)
+{
+  int ix = appIndex(app);
+  if(ix < 0)
+    return(false);
+
+  vector<unsigned int>& subs = m_subscribers[var];
+  if(find(subs.begin(), subs.end(), (unsigned int)(ix)) != subs.end())
+    return(true);
+  subs.push_back(ix);
+
+  map<string, CMOOSMsg>::const_iterator p = m_latest.find(var);
+  if(p != m_latest.end())
+    deliver(ix, p->second, m_now + m_latency);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: unsubscribe()
+
+bool FakeMOOSBus::unsubscribe(const CMOOSApp* app, const string& var)
+{
+  int ix = appIndex(app);
+  if((ix < 0) || (m_subscribers.count(var) == 0))
+    return(false);
+
+  vector<unsigned int>& subs = m_subscribers[var];
+  vector<unsigned int>::iterator p = find(subs.begin(), subs.end(), (unsigned int)(ix));
+  if(p == subs.end())
+    return(false);
+  subs.erase(p);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: getLatest()
+
+bool FakeMOOSBus::getLatest(const string& var, CMOOSMsg& msg) const
+{
+  map<string, CMOOSMsg>::const_iterator p = m_latest.find(var);
+  if(p == m_latest.end())
+    return(false);
+  msg = p->second;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: getAppName()
+
+string FakeMOOSBus::getAppName(unsigned int ix) const
+{
+  if(ix >= m_apps.size())
+    return("");
+  return(m_apps[ix].name);
+}
+
+//---------------------------------------------------------
+// Procedure: getStats()
+
+FakeMOOSBus::AppStats FakeMOOSBus::getStats(unsigned int ix) const
+{
+  if(ix < m_apps.size())
+    return(m_apps[ix].stats);
+
+  AppStats stats;
+  zeroStats(stats);
+  return(stats);
+}
+
+//---------------------------------------------------------
+// Procedure: getPending()
+
+unsigned long FakeMOOSBus::getPending() const
+{
+  unsigned long total = 0;
+  for(unsigned int i=0; i<m_apps.size(); i++)
+    total += m_apps[i].mailbox.size();
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: resetStats()
+
+void FakeMOOSBus::resetStats()
+{
+  for(unsigned int i=0; i<m_apps.size(); i++)
+    zeroStats(m_apps[i].stats);
+  m_delivered = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: appIndex()
+
+int FakeMOOSBus::appIndex(const CMOOSApp* app) const
+{
+  if(!app)
+    return(-1);
+  for(unsigned int i=0; i<m_apps.size(); i++) {
+    if(m_apps[i].app == app)
+      return(i);
+  }
+  return(-1);
+}
+
+//---------------------------------------------------------
+// Procedure: nextTick()
+
+double FakeMOOSBus::nextTick(const AppEntry& entry) const
+{
+  return(entry.start + entry.tick_count / entry.app_tick);
+}
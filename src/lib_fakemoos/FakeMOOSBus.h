@@ -0,0 +1,132 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: FakeMOOSBus.h                                        */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#ifndef FAKE_MOOS_BUS_HEADER
+#define FAKE_MOOS_BUS_HEADER
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include "MOOS/libMOOS/MOOSLib.h"
+
+#define FAKE_MOOS_EPOCH 1000000000.0
+
+// An in-process stand-in for the MOOSDB and the comms threads of the
+// apps attached to it. Apps are driven from a single thread on a
+// virtual clock: each app's iterations fall at multiples of its
+// AppTick, and at each one the app gets its due mail in OnNewMail and
+// then Iterate, as CMOOSApp does when CommsTick matches AppTick. Mail
+// posted with Notify reaches subscribers after a fixed virtual
+// latency (zero by default), so a run is repeatable message for
+// message and MOOSTime() reads the virtual clock. Wall time spent in
+// each app's OnNewMail and Iterate is kept apart from the time spent
+// routing its posts, separating app overhead from bus overhead.
+
+class FakeMOOSBus
+{
+ public:
+  // Apps take a zero time to mean "not started yet", so the virtual
+  // clock starts at a fixed nonzero epoch unless told otherwise
+  FakeMOOSBus(double start_time=FAKE_MOOS_EPOCH);
+  ~FakeMOOSBus();
+
+  // The bus MOOSTime() reads from, the most recently created one
+  static FakeMOOSBus* current();
+
+  // Attach an app and run its OnStartUp and OnConnectToServer. If
+  // either fails the app is detached again and false returned.
+  bool addApp(CMOOSApp* app, const std::string& name, double app_tick,
+              const STRING_LIST& config=STRING_LIST());
+
+  void setLatency(double secs)  {m_latency = (secs < 0) ? 0 : secs;};
+
+  // Post from outside any app, as uPokeDB would
+  void poke(const std::string& var, const std::string& sval);
+  void poke(const std::string& var, double dval);
+
+  // Advance the virtual clock by secs, running every app tick due
+  void run(double secs);
+  double now() const  {return(m_now);};
+
+  // Called by CMOOSApp
+  bool publish(CMOOSMsg& msg, const CMOOSApp* source);
+  bool subscribe(const CMOOSApp* app, const std::string& var);
+  bool unsubscribe(const CMOOSApp* app, const std::string& var);
+
+  // The latest post of a variable, as the DB would hold it
+  bool getLatest(const std::string& var, CMOOSMsg& msg) const;
+
+  struct AppStats {
+    unsigned long ticks;
+    unsigned long mail_calls;    // OnNewMail calls, one per tick with mail
+    unsigned long mail_msgs;     // messages delivered
+    unsigned long posts;         // Notify calls
+    double        post_bytes;
+    double        mail_ns;       // wall time in OnNewMail, less bus time
+    double        iterate_ns;    // wall time in Iterate, less bus time
+    double        bus_ns;        // wall time routing this app's posts
+  };
+
+  unsigned int size() const  {return(m_apps.size());};
+  std::string  getAppName(unsigned int ix) const;
+  AppStats     getStats(unsigned int ix) const;
+  unsigned long getDelivered() const  {return(m_delivered);};
+  unsigned long getPending() const;
+  void resetStats();
+
+ protected:
+  struct Pending {
+    double   due;
+    CMOOSMsg msg;
+  };
+
+  struct AppEntry {
+    CMOOSApp*     app;
+    std::string   name;
+    double        app_tick;
+    unsigned long tick_count;    // the next tick is at start + count/app_tick
+    double        start;
+    std::deque<Pending> mailbox;
+    AppStats      stats;
+  };
+
+  int  appIndex(const CMOOSApp* app) const;
+  void removeLastApp();
+  double nextTick(const AppEntry& entry) const;
+  void runTick(unsigned int ix);
+  void deliver(unsigned int ix, const CMOOSMsg& msg, double due);
+
+ private:
+  double m_now;
+  double m_latency;
+  double m_bus_ns;               // running total, all apps
+
+  std::vector<AppEntry> m_apps;
+  std::map<std::string, std::vector<unsigned int> > m_subscribers;
+  std::map<std::string, CMOOSMsg> m_latest;
+  unsigned long m_delivered;
+
+  FakeMOOSBus* m_prev_current;
+};
+
+#endif
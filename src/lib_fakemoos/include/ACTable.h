@@ -0,0 +1,57 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: ACTable.h                                            */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#ifndef FAKE_AC_TABLE_HEADER
+#define FAKE_AC_TABLE_HEADER
+
+#include <string>
+#include <vector>
+
+// Stand-in for the apputil ACTable used by appcast reports, so that
+// targets built on lib_fakemoos need not link apputil. As with the
+// original, a string fed in with "|" separators fills one cell per
+// field, and rows wrap after the given number of columns.
+
+class ACTable
+{
+ public:
+  ACTable(unsigned int columns, unsigned int separation=2);
+  ~ACTable() {};
+
+  ACTable& operator<<(const std::string& str);
+  ACTable& operator<<(const char* str)  {return(*this << std::string(str));};
+
+  void addHeaderLines(unsigned int max_width=0);
+  void setColumnJustify(unsigned int column, std::string justify);
+
+  std::string getFormattedString() const;
+
+ protected:
+  unsigned int m_columns;
+  unsigned int m_separation;
+
+  std::vector<std::string> m_cells;
+  std::vector<bool>        m_right_justify;
+  std::vector<unsigned int> m_header_rows;   // rows that are dashes
+};
+
+#endif
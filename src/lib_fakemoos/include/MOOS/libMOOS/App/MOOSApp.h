@@ -0,0 +1,102 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: MOOSApp.h                                            */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#ifndef FAKE_MOOS_APP_HEADER
+#define FAKE_MOOS_APP_HEADER
+
+#include <string>
+#include <list>
+#include <vector>
+#include <cstddef>
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+// Stand-in for the libMOOS CMOOSApp. Notify and Register go to the
+// FakeMOOSBus the app was added to rather than to a MOOSDB, and the
+// bus, not a comms thread, decides when OnNewMail and Iterate run.
+// Only the parts of the interface used by the apps in this tree are
+// provided.
+
+typedef std::list<std::string> STRING_LIST;
+
+class FakeMOOSBus;
+
+class CProcessConfigReader
+{
+ public:
+  CProcessConfigReader() {m_verbatim=false;};
+  virtual ~CProcessConfigReader() {};
+
+  // The app's configuration block, as "param = value" lines
+  bool GetConfiguration(std::string app_name, STRING_LIST& params);
+  bool GetValue(std::string name, std::string& value);
+  void EnableVerbatimQuoting(bool v) {m_verbatim=v;};
+
+  void SetConfiguration(const STRING_LIST& params) {m_params=params;};
+  void SetGlobal(std::string name, std::string value);
+
+ protected:
+  STRING_LIST m_params;
+  STRING_LIST m_globals;
+  bool        m_verbatim;
+};
+
+class CMOOSApp
+{
+ public:
+  CMOOSApp();
+  virtual ~CMOOSApp() {};
+
+  virtual bool Iterate() = 0;
+  virtual bool OnNewMail(MOOSMSG_LIST& /*NewMail*/) {return(true);};
+  virtual bool OnStartUp()                      {return(true);};
+  virtual bool OnConnectToServer()              {return(true);};
+
+  bool Notify(const std::string& var, const std::string& sval, double time=-1);
+  bool Notify(const std::string& var, const char* sval, double time=-1);
+  bool Notify(const std::string& var, double dval, double time=-1);
+  bool Notify(const std::string& var, const std::vector<unsigned char>& data,
+              double time=-1);
+  bool Notify(const std::string& var, void* data, size_t size, double time=-1);
+
+  bool Register(const std::string& var, double interval=0);
+  bool UnRegister(const std::string& var);
+
+  std::string GetAppName() const  {return(m_sAppName);};
+  double GetAppFreq() const       {return(m_dfFreq);};
+  double GetTimeWarp() const      {return(1);};
+
+ public: // Called by the bus
+  void AttachToBus(FakeMOOSBus* bus, const std::string& name, double freq,
+                   const STRING_LIST& config);
+  void DetachFromBus()  {m_bus = 0;};
+
+ protected:
+  CProcessConfigReader m_MissionReader;
+  std::string  m_sAppName;
+  double       m_dfFreq;
+  FakeMOOSBus* m_bus;
+};
+
+double MOOSTime(bool apply_time_warp=true);
+double MOOSLocalTime(bool apply_time_warp=true);
+
+#endif
@@ -0,0 +1,83 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: MOOSMsg.h                                            */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#ifndef FAKE_MOOS_MSG_HEADER
+#define FAKE_MOOS_MSG_HEADER
+
+#include <string>
+#include <list>
+#include <vector>
+
+// Stand-in for the libMOOS CMOOSMsg, carrying only what the apps in
+// this tree read from their mail: key, string/double/binary value,
+// time and source. Field names follow libMOOS so app code that pokes
+// at them directly still compiles.
+
+#define MOOS_DOUBLE 'D'
+#define MOOS_STRING 'S'
+#define MOOS_BINARY_STRING 'B'
+
+class CMOOSMsg
+{
+ public:
+  CMOOSMsg();
+  CMOOSMsg(const std::string& key, const std::string& sval, double time);
+  CMOOSMsg(const std::string& key, double dval, double time);
+  CMOOSMsg(const std::string& key, const unsigned char* data,
+           unsigned int size, double time);
+  virtual ~CMOOSMsg() {};
+
+  std::string GetKey() const        {return(m_sKey);};
+  std::string GetName() const       {return(m_sKey);};
+  std::string GetString() const     {return(m_sVal);};
+  double      GetDouble() const     {return(m_dfVal);};
+  double      GetTime() const       {return(m_dfTime);};
+  std::string GetSource() const     {return(m_sSrc);};
+  std::string GetSourceAux() const  {return(m_sSrcAux);};
+  std::string GetCommunity() const  {return(m_sOriginatingCommunity);};
+
+  bool IsDouble() const  {return(m_cDataType == MOOS_DOUBLE);};
+  bool IsString() const  {return(m_cDataType == MOOS_STRING);};
+  bool IsBinary() const  {return(m_cDataType == MOOS_BINARY_STRING);};
+  bool IsDataType(char type) const  {return(m_cDataType == type);};
+
+  // Binary payloads live in m_sVal, as they do in libMOOS
+  unsigned int GetBinaryDataSize() const;
+  const unsigned char* GetBinaryData() const;
+  std::vector<unsigned char> GetBinaryDataAsVector() const;
+
+  void Trace() const;
+
+ public:
+  char        m_cDataType;
+  std::string m_sKey;
+  std::string m_sVal;
+  double      m_dfVal;
+  double      m_dfTime;
+  std::string m_sSrc;
+  std::string m_sSrcAux;
+  std::string m_sOriginatingCommunity;
+};
+
+typedef std::list<CMOOSMsg> MOOSMSG_LIST;
+
+#endif
@@ -0,0 +1,84 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: AppCastingMOOSApp.h                                  */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#ifndef FAKE_APPCASTING_MOOS_APP_HEADER
+#define FAKE_APPCASTING_MOOS_APP_HEADER
+
+#include <string>
+#include <sstream>
+#include <list>
+#include <map>
+#include "MOOS/libMOOS/MOOSLib.h"
+
+// Stand-in for AppCastingMOOSApp. As with the real class, the report
+// is only built and posted as APPCAST while an APPCAST_REQ naming the
+// app (or "any") is in force, so by default a benchmark pays for the
+// appcast bookkeeping but not for buildReport(). Post an APPCAST_REQ
+// to the bus to include report building in the measurement.
+
+class AppCastingMOOSApp : public CMOOSApp
+{
+ public:
+  AppCastingMOOSApp();
+  virtual ~AppCastingMOOSApp() {};
+
+  virtual bool Iterate();
+  virtual bool OnNewMail(MOOSMSG_LIST& NewMail);
+  virtual bool OnStartUp();
+  virtual bool buildReport() {return(true);};
+
+  void RegisterVariables();
+  void PostReport(const std::string& directive="");
+
+  void reportEvent(const std::string& str);
+  void reportConfigWarning(const std::string& str);
+  void reportUnhandledConfigWarning(const std::string& str);
+  void reportRunWarning(const std::string& str);
+  void retractRunWarning(const std::string& str);
+
+  unsigned int getReportsBuilt() const  {return(m_reports_built);};
+  std::string  getLastReport() const    {return(m_last_report);};
+  unsigned int getRunWarnings() const   {return(m_run_warnings.size());};
+  unsigned int getConfigWarnings() const {return(m_config_warnings.size());};
+
+ protected:
+  void handleAppCastRequest(const std::string& request);
+
+ protected:
+  std::stringstream m_msgs;
+  std::string  m_host_community;
+  unsigned int m_iteration;
+  double       m_curr_time;
+  double       m_last_report_time;
+  double       m_term_report_interval;
+
+ private:
+  double       m_appcast_until;
+  unsigned int m_reports_built;
+  std::string  m_last_report;
+
+  std::list<std::string>             m_events;
+  std::list<std::string>             m_config_warnings;
+  std::map<std::string, unsigned int> m_run_warnings;
+};
+
+#endif
@@ -0,0 +1,84 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: PointBatch.cpp                                  */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include "MBUtils.h"
+#include "PointBatch.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Procedure: pointChecksum()
+//   Purpose: Fletcher-32 over the bytes of the payload, as eight
+//            lowercase hex digits.
+
+string pointChecksum(const string& payload)
+{
+  unsigned long sum1 = 0xffff;
+  unsigned long sum2 = 0xffff;
+  for(unsigned int i=0; i<payload.length(); i++) {
+    sum1 = (sum1 + (unsigned char)(payload[i])) % 0xffff;
+    sum2 = (sum2 + sum1) % 0xffff;
+  }
+
+  char buff[16];
+  sprintf(buff, "%08lx", (sum2 << 16) | sum1);
+  return(buff);
+}
+
+//---------------------------------------------------------
+// Procedure: buildPointBatch()
+
+string buildPointBatch(unsigned int seq, const vector<string>& pts,
+                       bool want_ack)
+{
+  string payload;
+  for(unsigned int i=0; i<pts.size(); i++) {
+    if(i > 0)
+      payload += ";";
+    payload += pts[i];
+  }
+
+  string msg = "batch=" + uintToString(seq);
+  msg += ",n=" + uintToString(pts.size());
+  if(want_ack)
+    msg += ",ack=1";
+  msg += ",sum=" + pointChecksum(payload);
+  msg += ";" + payload;
+  return(msg);
+}
+
+//---------------------------------------------------------
+// Procedure: parsePointBatch()
+
+bool parsePointBatch(const string& msg, unsigned int& seq,
+                     vector<string>& pts, bool& want_ack)
+{
+  pts.clear();
+
+  string payload = msg;
+  string header  = biteString(payload, ';');
+
+  string seq_str = tokStringParse(header, "batch", ',', '=');
+  string amt_str = tokStringParse(header, "n", ',', '=');
+  string sum_str = tokStringParse(header, "sum", ',', '=');
+  if(!isNumber(seq_str) || !isNumber(amt_str) || (sum_str == ""))
+    return(false);
+
+  if(pointChecksum(payload) != sum_str)
+    return(false);
+
+  vector<string> parts = parseString(payload, ';');
+  if(parts.size() != (unsigned int)(atoi(amt_str.c_str())))
+    return(false);
+
+  seq = atoi(seq_str.c_str());
+  want_ack = (tokStringParse(header, "ack", ',', '=') == "1");
+  pts = parts;
+  return(true);
+}
@@ -0,0 +1,34 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: PointBatch.h                                    */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+#ifndef POINT_BATCH_HEADER
+#define POINT_BATCH_HEADER
+
+#include <string>
+#include <vector>
+
+// Wire format shared by pPointAssign and pGenPath for sending several
+// visit points in one VISIT_POINT message:
+//
+//   batch=4,n=3,sum=1c2f09a4;x=1,y=2,id=7;x=5,y=9,id=8;x=0,y=4,id=9
+//
+// seq counts up per vehicle from 1, n is the number of points and sum
+// is a Fletcher-32 checksum of everything after the first ';'. A batch
+// sent for acknowledged delivery also carries ack=1 in its header.
+
+std::string pointChecksum(const std::string& payload);
+
+std::string buildPointBatch(unsigned int seq,
+                            const std::vector<std::string>& pts,
+                            bool want_ack=false);
+
+// Returns false if the message is malformed or fails its checksum,
+// in which case pts is left empty.
+bool parsePointBatch(const std::string& msg, unsigned int& seq,
+                     std::vector<std::string>& pts, bool& want_ack);
+
+#endif
@@ -0,0 +1,195 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: PointLink.cpp                                   */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+#include <cstdlib>
+#include "MBUtils.h"
+#include "PointLink.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Procedure: buildPointAck()
+
+string buildPointAck(const string& vname, unsigned int cum,
+                     const vector<unsigned int>& sacks)
+{
+  string msg = "vname=" + vname + ",cum=" + uintToString(cum);
+  if(!sacks.empty()) {
+    msg += ",sack=";
+    for(unsigned int i=0; i<sacks.size(); i++) {
+      if(i > 0)
+        msg += ":";
+      msg += uintToString(sacks[i]);
+    }
+  }
+  return(msg);
+}
+
+//---------------------------------------------------------
+// Procedure: parsePointAck()
+
+bool parsePointAck(const string& msg, string& vname, unsigned int& cum,
+                   vector<unsigned int>& sacks)
+{
+  sacks.clear();
+  vname = tokStringParse(msg, "vname", ',', '=');
+  string cum_str = tokStringParse(msg, "cum", ',', '=');
+  if((vname == "") || !isNumber(cum_str))
+    return(false);
+  cum = atoi(cum_str.c_str());
+
+  vector<string> parts = parseString(tokStringParse(msg, "sack", ',', '='), ':');
+  for(unsigned int i=0; i<parts.size(); i++) {
+    if(isNumber(parts[i]))
+      sacks.push_back(atoi(parts[i].c_str()));
+  }
+  return(true);
+}
+
+//---------------------------------------------------------
+// Constructor()
+
+PointSender::PointSender()
+{
+  m_base_timeout = 4;
+  m_max_timeout  = 60;
+  m_retransmits  = 0;
+  m_acked        = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: setTimeouts()
+
+void PointSender::setTimeouts(double base_timeout, double max_timeout)
+{
+  m_base_timeout = base_timeout;
+  m_max_timeout  = max_timeout;
+  if(m_max_timeout < m_base_timeout)
+    m_max_timeout = m_base_timeout;
+}
+
+//---------------------------------------------------------
+// Procedure: addSent()
+
+void PointSender::addSent(unsigned int seq, double curr_time)
+{
+  Outgoing out;
+  out.sent_time = curr_time;
+  out.timeout   = m_base_timeout;
+  out.due_time  = curr_time + m_base_timeout;
+  m_unacked[seq] = out;
+}
+
+//---------------------------------------------------------
+// Procedure: handleAck()
+//   Purpose: Retire acknowledged batches. Any batch below the highest
+//            sack that is still missing is pulled forward to resend.
+//   Returns: The number of batches newly acknowledged.
+
+unsigned int PointSender::handleAck(unsigned int cum,
+                                    const vector<unsigned int>& sacks,
+                                    double curr_time)
+{
+  unsigned int amt = m_unacked.size();
+
+  while(!m_unacked.empty() && (m_unacked.begin()->first <= cum))
+    m_unacked.erase(m_unacked.begin());
+
+  unsigned int max_sack = 0;
+  for(unsigned int i=0; i<sacks.size(); i++) {
+    m_unacked.erase(sacks[i]);
+    if(sacks[i] > max_sack)
+      max_sack = sacks[i];
+  }
+
+  map<unsigned int, Outgoing>::iterator p;
+  for(p=m_unacked.begin(); p!=m_unacked.end(); p++) {
+    if(p->first > max_sack)
+      break;
+    double earliest = p->second.sent_time + m_base_timeout;
+    if(p->second.due_time > earliest)
+      p->second.due_time = (earliest > curr_time) ? earliest : curr_time;
+  }
+
+  amt -= m_unacked.size();
+  m_acked += amt;
+  return(amt);
+}
+
+//---------------------------------------------------------
+// Procedure: getDue()
+
+vector<unsigned int> PointSender::getDue(double curr_time, unsigned int max_amt)
+{
+  vector<unsigned int> due;
+  map<unsigned int, Outgoing>::iterator p;
+  for(p=m_unacked.begin(); p!=m_unacked.end(); p++) {
+    if((max_amt > 0) && (due.size() >= max_amt))
+      break;
+    Outgoing& out = p->second;
+    if(out.due_time > curr_time)
+      continue;
+
+    due.push_back(p->first);
+    out.timeout *= 2;
+    if(out.timeout > m_max_timeout)
+      out.timeout = m_max_timeout;
+    out.sent_time = curr_time;
+    out.due_time  = curr_time + out.timeout;
+    m_retransmits++;
+  }
+  return(due);
+}
+
+//---------------------------------------------------------
+// Constructor()
+
+PointReceiver::PointReceiver()
+{
+  m_cum = 0;
+  m_duplicates = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: addBatch()
+
+bool PointReceiver::addBatch(unsigned int seq, const vector<string>& items)
+{
+  if((seq <= m_cum) || m_held.count(seq)) {
+    m_duplicates++;
+    return(false);
+  }
+  m_held[seq] = items;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: popReady()
+
+vector<string> PointReceiver::popReady()
+{
+  vector<string> ready;
+  while(!m_held.empty() && (m_held.begin()->first == m_cum + 1)) {
+    const vector<string>& items = m_held.begin()->second;
+    ready.insert(ready.end(), items.begin(), items.end());
+    m_held.erase(m_held.begin());
+    m_cum++;
+  }
+  return(ready);
+}
+
+//---------------------------------------------------------
+// Procedure: getAck()
+
+string PointReceiver::getAck(const string& vname) const
+{
+  vector<unsigned int> sacks;
+  map<unsigned int, vector<string> >::const_iterator p;
+  for(p=m_held.begin(); p!=m_held.end(); p++)
+    sacks.push_back(p->first);
+  return(buildPointAck(vname, m_cum, sacks));
+}
@@ -0,0 +1,103 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: PointLink.h                                     */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+#ifndef POINT_LINK_HEADER
+#define POINT_LINK_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+
+// Acknowledged delivery of point batches over a lossy link. The
+// vehicle acknowledges each batch it hears with
+//
+//   vname=henry,cum=12,sack=14:16:17
+//
+// where cum is the highest sequence number up to which it has
+// received everything, and sack lists sequence numbers it holds above
+// cum. The sender resends only the batches still missing.
+
+std::string buildPointAck(const std::string& vname, unsigned int cum,
+                          const std::vector<unsigned int>& sacks);
+
+bool parsePointAck(const std::string& msg, std::string& vname,
+                   unsigned int& cum, std::vector<unsigned int>& sacks);
+
+//---------------------------------------------------------
+// Shoreside: the batches sent to one vehicle not yet acknowledged.
+// Each waits timeout seconds before it is resent, and the timeout
+// doubles on every resend up to max_timeout. A batch the vehicle has
+// reported a gap for (a sack above it) is resent without waiting out
+// the rest of its timeout, but no sooner than base_timeout after its
+// last send. Only sequence numbers and timing are kept here; the
+// caller keeps what each batch held and rebuilds it for a resend.
+
+class PointSender
+{
+ public:
+  PointSender();
+  ~PointSender() {};
+
+  void setTimeouts(double base_timeout, double max_timeout);
+
+  void addSent(unsigned int seq, double curr_time);
+  unsigned int handleAck(unsigned int cum,
+                         const std::vector<unsigned int>& sacks,
+                         double curr_time);
+
+  // Sequence numbers of the batches due to be resent now, oldest
+  // first, at most max_amt (0 means no limit).
+  std::vector<unsigned int> getDue(double curr_time, unsigned int max_amt);
+
+  unsigned int sizeUnacked() const    {return(m_unacked.size());};
+  unsigned int getRetransmits() const {return(m_retransmits);};
+  unsigned int getAcked() const       {return(m_acked);};
+
+ private:
+  struct Outgoing {
+    double sent_time;
+    double due_time;
+    double timeout;
+  };
+
+  double m_base_timeout;
+  double m_max_timeout;
+
+  std::map<unsigned int, Outgoing> m_unacked;
+  unsigned int m_retransmits;
+  unsigned int m_acked;
+};
+
+//---------------------------------------------------------
+// Vehicle side: puts batches back in sequence order. A batch is only
+// released once every batch before it has been released, so a lost
+// "firstpoint" can not arrive after the points that follow it.
+
+class PointReceiver
+{
+ public:
+  PointReceiver();
+  ~PointReceiver() {};
+
+  // Returns false if the batch was already received.
+  bool addBatch(unsigned int seq, const std::vector<std::string>& items);
+
+  // Items of all batches now in sequence, in order.
+  std::vector<std::string> popReady();
+
+  std::string  getAck(const std::string& vname) const;
+  unsigned int getCumulative() const {return(m_cum);};
+  unsigned int sizeHeld() const      {return(m_held.size());};
+  unsigned int getDuplicates() const {return(m_duplicates);};
+
+ private:
+  unsigned int m_cum;
+  std::map<unsigned int, std::vector<std::string> > m_held;
+  unsigned int m_duplicates;
+};
+
+#endif
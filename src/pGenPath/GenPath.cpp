@@ -11,6 +11,7 @@
 #include "MBUtils.h"
 #include "ACTable.h"
 #include "GenPath.h"
+#include "PointBatch.h"
 
 using namespace std;
 
@@ -30,6 +31,10 @@ GenPath::GenPath()
   m_received_first_point = false;
   m_received_last_point = false;
   m_mission_complete = false;
+  m_batches_recd = 0;
+  m_batches_bad = 0;
+  m_batch_gaps = 0;
+  m_batch_last_seq = 0;
 }
 
 //---------------------------------------------------------
@@ -179,6 +184,15 @@ bool GenPath::buildReport()
   m_msgs << "  Mission Complete: " << (m_mission_complete ? "yes" : "no") << endl;
   
   m_msgs << "Points Received: " << m_points.size() << endl;
+  if (m_batches_recd > 0 || m_batches_bad > 0) {
+    m_msgs << "Batches Received: " << m_batches_recd;
+    m_msgs << " (bad: " << m_batches_bad << ", gaps: " << m_batch_gaps << ")" << endl;
+    if (m_receiver.getCumulative() > 0) {
+      m_msgs << "  In sequence up to: " << m_receiver.getCumulative();
+      m_msgs << ", held out of order: " << m_receiver.sizeHeld();
+      m_msgs << ", repeats: " << m_receiver.getDuplicates() << endl;
+    }
+  }
   
   if (!m_points.empty()) {
     ACTable actab(5);
@@ -225,6 +239,14 @@ void GenPath::handleVisitPoint(const string& point_str)
     m_received_last_point = true;
     return;
   }
+  else if (strBegins(point_str, "batch=")) {
+    handlePointBatch(point_str);
+    return;
+  }
+  else if (strBegins(point_str, "drop=")) {
+    handleDropPoints(point_str.substr(5));
+    return;
+  }
   
   // Parse regular point
   vector<string> parts = parseString(point_str, ',');
@@ -248,10 +270,81 @@ void GenPath::handleVisitPoint(const string& point_str)
   
   // Initialize point as not visited
   m_visited_points.push_back(false);
+
+  // A point arriving after the path was built (e.g. re-auctioned
+  // from a teammate) means the path needs to be rebuilt.
+  if (m_received_last_point)
+    m_path_complete = false;
   
   reportEvent("Added point to list: " + point_str);
 }
 
+//---------------------------------------------------------
+// Procedure: handlePointBatch
+//   Purpose: Unpack a batch of points sent by pPointAssign. A batch
+//            that fails its checksum is dropped whole. Batches that
+//            ask for an ack are applied strictly in sequence order,
+//            and every one heard, even a repeat, is acked so the
+//            shoreside can stop resending it.
+
+void GenPath::handlePointBatch(const string& batch_str)
+{
+  unsigned int seq = 0;
+  vector<string> pts;
+  bool want_ack = false;
+  if (!parsePointBatch(batch_str, seq, pts, want_ack)) {
+    m_batches_bad++;
+    reportRunWarning("Dropped malformed or corrupt point batch");
+    return;
+  }
+
+  if (want_ack) {
+    if (m_receiver.addBatch(seq, pts))
+      m_batches_recd++;
+    vector<string> ready = m_receiver.popReady();
+    for (size_t i = 0; i < ready.size(); i++)
+      handleVisitPoint(ready[i]);
+    Notify("VISIT_POINT_ACK", m_receiver.getAck(m_host_community));
+    return;
+  }
+
+  if (seq > m_batch_last_seq + 1)
+    m_batch_gaps += seq - m_batch_last_seq - 1;
+  if (seq > m_batch_last_seq)
+    m_batch_last_seq = seq;
+  m_batches_recd++;
+
+  for (size_t i = 0; i < pts.size(); i++)
+    handleVisitPoint(pts[i]);
+}
+
+//---------------------------------------------------------
+// Procedure: handleDropPoints
+//   Purpose: Forget points the shoreside has handed to another
+//            vehicle. The ids are colon separated, e.g. "7:12:31".
+
+void GenPath::handleDropPoints(const string& ids_str)
+{
+  vector<string> ids = parseString(ids_str, ':');
+  unsigned int dropped = 0;
+  for (size_t i = 0; i < ids.size(); i++) {
+    string id = stripBlankEnds(ids[i]);
+    for (size_t j = 0; j < m_points.size(); j++) {
+      if (m_points[j].get_label() == id) {
+        m_points.erase(m_points.begin() + j);
+        m_visited_points.erase(m_visited_points.begin() + j);
+        dropped++;
+        break;
+      }
+    }
+  }
+
+  if (dropped > 0 && m_received_last_point)
+    m_path_complete = false;
+
+  reportEvent("Dropped " + uintToString(dropped) + " points: " + ids_str);
+}
+
 //---------------------------------------------------------
 // Procedure: generatePath
 
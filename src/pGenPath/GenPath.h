@@ -14,6 +14,7 @@
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
 #include "XYPoint.h"
 #include "XYSegList.h"
+#include "PointLink.h"
 
 class GenPath : public AppCastingMOOSApp
 {
@@ -33,6 +34,8 @@ class GenPath : public AppCastingMOOSApp
  protected:
    void registerVariables();
    void handleVisitPoint(const std::string& point_str);
+   void handleDropPoints(const std::string& ids_str);
+   void handlePointBatch(const std::string& batch_str);
    void generatePath();
    void checkVisitedPoints();
    void regeneratePath();
@@ -54,6 +57,12 @@ class GenPath : public AppCastingMOOSApp
    bool m_received_last_point;
    bool m_mission_complete;
    bool m_initial_mission_complete;
+
+   unsigned int m_batches_recd;
+   unsigned int m_batches_bad;      // malformed or failed checksum
+   unsigned int m_batch_gaps;       // sequence numbers skipped
+   unsigned int m_batch_last_seq;
+   PointReceiver m_receiver;        // orders batches sent with ack=1
 };
 
 #endif
\ No newline at end of file
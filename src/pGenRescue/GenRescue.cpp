@@ -11,6 +11,7 @@
 #include <ctime>
 #include <vector>
 #include <algorithm>
+#include <chrono>
 #include "MBUtils.h"
 #include "ACTable.h"
 #include "GenRescue.h"
@@ -35,6 +36,14 @@ GenRescue::GenRescue()
   m_hostname = "abe";
   m_dest_name = "ben";
   m_moos_varname = "SURVEY_UPDATE";
+
+  m_cooperative = false;
+  m_claim_var = "RESCUE_CLAIM";
+  m_claim_interval = 5;
+  m_rebalance_ratio = 1.5;
+  m_claims_dirty = false;
+  m_last_claim_time = 0;
+  m_tour_len = 0;
 }
 
 //---------------------------------------------------------
@@ -67,7 +76,8 @@ bool GenRescue::OnNewMail(MOOSMSG_LIST &NewMail)
 #endif
      if (key == "SWIMMER_ALERT") {
         string sval = msg.GetString();
-        addPoint(sval);
+        if (addPoint(sval))
+          m_replan_stats.noteAlert(msg.GetTime());
         regenerateFlag = true;
       }
 
@@ -85,6 +95,12 @@ bool GenRescue::OnNewMail(MOOSMSG_LIST &NewMail)
         regenerateFlag = true;
      }
 
+     else if (m_cooperative && (key == m_claim_var)) {
+        string sval = msg.GetString();
+        if (m_claims.handleClaimMsg(sval, MOOSTime()))
+          regenerateFlag = true;
+     }
+
      else if (key == "GENRESCUE_REGENERATE") {
         string sval = msg.GetString();
         if (sval == "regenerate_request") {
@@ -116,6 +132,8 @@ bool GenRescue::Iterate()
 {
   AppCastingMOOSApp::Iterate();
   // Do your thing here!
+  m_id_history.prune(MOOSTime());
+
   XYPoint currPos(navx, navy);
   for (int i = 0; i < pointList.size(); ++i) {
     if (pointBool[i] == false) {
@@ -127,8 +145,17 @@ bool GenRescue::Iterate()
       numPoints--;
     }
   }
+  if (m_cooperative) {
+    updateClaims();
+  }
   if (regenerateFlag) {
-    generatePath();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool built = generatePath();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    if (built) {
+      bool alert = m_replan_stats.noteReplan(elapsed.count(), MOOSTime());
+      postReplanStats(alert);
+    }
   }
   AppCastingMOOSApp::PostReport();
   return(true);
@@ -165,11 +192,52 @@ bool GenRescue::OnStartUp()
       setDoubleOnString(m_visit_radius, value);
       handled = true;
     }
+    else if(param == "cooperative") {
+      handled = setBooleanOnString(m_cooperative, value);
+    }
+    else if(param == "claim_var") {
+      handled = setNonWhiteVarOnString(m_claim_var, toupper(value));
+    }
+    else if(param == "claim_interval") {
+      handled = setPosDoubleOnString(m_claim_interval, value);
+    }
+    else if(param == "rebalance_ratio") {
+      handled = setDoubleOnString(m_rebalance_ratio, value);
+      if(m_rebalance_ratio < 1)
+        m_rebalance_ratio = 1;
+    }
+    else if(param == "teammate_stale") {
+      double secs = 0;
+      if(setDoubleOnString(secs, value))
+        handled = m_claims.setStaleThresh(secs);
+    }
+    else if(param == "dest_name") {
+      handled = setNonWhiteVarOnString(m_dest_name, value);
+    }
+    else if(param == "history_max_ids") {
+      unsigned int amt = 0;
+      if(setUIntOnString(amt, value))
+        handled = m_id_history.setMaxRecent(amt);
+    }
+    else if(param == "history_max_age") {
+      double secs = 0;
+      if(setDoubleOnString(secs, value))
+        handled = m_id_history.setMaxAge(secs);
+    }
+    else if(param == "history_bloom_bits") {
+      unsigned int bits = 0;
+      if(setUIntOnString(bits, value))
+        handled = m_id_history.setBloomBits(bits);
+    }
 
     if(!handled)
       reportUnhandledConfigWarning(orig);
 
   }
+
+  if(m_host_community != "")
+    m_hostname = m_host_community;
+  m_claims.setOwnName(m_hostname);
   
   registerVariables();	
   Notify("READY_STATUS", m_host_community);
@@ -187,14 +255,17 @@ void GenRescue::registerVariables()
   Register("NAV_X", 0);
   Register("NAV_Y", 0);
   Register("GENRESCUE_REGENERATE", 0);
+  if(m_cooperative)
+    Register(m_claim_var, 0);
   //Register("WPT_STAT", 0);
   // Register("FOOBAR", 0);
 }
 
 //---------------------------------------------------------
 // Procedure: addPoint()
+//   Returns: true if the swimmer id had not been seen before.
 
-void GenRescue::addPoint(std::string report)
+bool GenRescue::addPoint(std::string report)
 {
   size_t ind_x = report.find("x=");
   size_t ind_y = report.find("y=");
@@ -205,24 +276,22 @@ void GenRescue::addPoint(std::string report)
   double x_coord = std::stod(x_string);
   double y_coord = std::stod(y_string);
 
-  bool addToBuffer = true;
-  if (pointHistory.size() > 0) {
-    for (auto it = pointHistory.begin(); it != pointHistory.end(); ) {
-      if (it->get_label() == id_string) {
-        addToBuffer = false;
-      }
-      ++it;
-    }
-  }
+  if (m_id_history.contains(id_string))
+    return(false);
 
-  if (addToBuffer) {
-    XYPoint point(x_coord, y_coord);
-    point.set_label(id_string);
-    pointList.push_back(point);
-    pointBool.push_back(true);
-    pointHistory.push_back(point);
-    numPoints++;
+  XYPoint point(x_coord, y_coord);
+  point.set_label(id_string);
+  pointList.push_back(point);
+  pointBool.push_back(true);
+  m_id_history.add(id_string, MOOSTime());
+  numPoints++;
+
+  if (m_cooperative) {
+    m_claims.claimOwn(id_string, insertionCost(x_coord, y_coord));
+    m_claims_dirty = true;
   }
+
+  return(true);
 }
 
 //---------------------------------------------------------
@@ -232,25 +301,136 @@ void GenRescue::removePoint(std::string report)
   size_t ind_id = report.find("id=");
   string id_string = report.substr(ind_id + 3, ind_id + 5);
 
-  for (auto it = pointList.begin(); it != pointList.end(); ) {
-    if (it->get_label() == id_string) {
-        it = pointList.erase(it);
+  m_claims.removeSwimmer(id_string);
+
+  for (size_t i = 0; i < pointList.size(); ) {
+    if (pointList[i].get_label() == id_string) {
+        pointList.erase(pointList.begin() + i);
+        pointBool.erase(pointBool.begin() + i);
         numPoints--;
     } else {
-        ++it;
+        ++i;
+    }
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: insertionCost()
+//   Purpose: Approximate the marginal cost of adding a swimmer to
+//            our tour as its distance to the nearest of ownship or
+//            any swimmer we already own and have not yet reached.
+
+double GenRescue::insertionCost(double x, double y) const
+{
+  double cost = hypot(navx - x, navy - y);
+  for (size_t i = 0; i < pointList.size(); ++i) {
+    if (!pointBool[i] || !m_claims.ownedBySelf(pointList[i].get_label()))
+      continue;
+    double dist = hypot(pointList[i].get_vx() - x, pointList[i].get_vy() - y);
+    if (dist < cost)
+      cost = dist;
+  }
+  return(cost);
+}
+
+//---------------------------------------------------------
+// Procedure: updateClaims()
+//   Purpose: Bid on swimmers released by teammates that went quiet,
+//            then rebalance and share our claims on the interval.
+
+void GenRescue::updateClaims()
+{
+  double curr_time = MOOSTime();
+
+  vector<string> released = m_claims.releaseStale(curr_time);
+  for (size_t i = 0; i < pointList.size(); ++i) {
+    const string& id = pointList[i].get_label();
+    if (pointBool[i] && (m_claims.getOwner(id) == "")) {
+      m_claims.claimOwn(id, insertionCost(pointList[i].get_vx(),
+                                          pointList[i].get_vy()));
+      m_claims_dirty = true;
     }
   }
+  if (released.size() > 0) {
+    reportEvent("Re-claimed swimmers from stale teammates or unconfirmed gives: " +
+                uintToString(released.size()));
+    regenerateFlag = true;
+  }
+
+  if (!m_claims_dirty && ((curr_time - m_last_claim_time) < m_claim_interval))
+    return;
+
+  if (rebalanceClaims())
+    regenerateFlag = true;
+  postClaims();
+}
+
+//---------------------------------------------------------
+// Procedure: rebalanceClaims()
+//   Purpose: If our tour is much longer than the shortest teammate
+//            tour, hand the swimmer closest to that teammate over.
+
+bool GenRescue::rebalanceClaims()
+{
+  string vname;
+  double tx = 0, ty = 0, tour_len = 0;
+  if (!m_claims.getShortestTeammate(MOOSTime(), vname, tx, ty, tour_len))
+    return(false);
+  if (m_claims.sizeOwned(m_hostname) < 2)
+    return(false);
+  if (m_tour_len <= (m_rebalance_ratio * tour_len) + m_visit_radius)
+    return(false);
+
+  int    best_ix   = -1;
+  double best_dist = 0;
+  for (size_t i = 0; i < pointList.size(); ++i) {
+    if (!pointBool[i] || !m_claims.ownedBySelf(pointList[i].get_label()))
+      continue;
+    double dist = hypot(pointList[i].get_vx() - tx, pointList[i].get_vy() - ty);
+    if ((best_ix < 0) || (dist < best_dist)) {
+      best_ix   = i;
+      best_dist = dist;
+    }
+  }
+  if (best_ix < 0)
+    return(false);
+
+  string id = pointList[best_ix].get_label();
+  if (!m_claims.giveTo(id, vname, best_dist, MOOSTime()))
+    return(false);
+
+  reportEvent("Gave swimmer " + id + " to " + vname);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: postClaims()
+
+void GenRescue::postClaims()
+{
+  NodeMessage node_message;
+  node_message.setSourceNode(m_hostname);
+  node_message.setDestNode("all");
+  node_message.setVarName(m_claim_var);
+  node_message.setStringVal(m_claims.getClaimMsg(navx, navy, m_tour_len));
+
+  notifyCounted("NODE_MESSAGE_LOCAL", node_message.getSpec());
+
+  m_claims_dirty = false;
+  m_last_claim_time = MOOSTime();
 }
 
 //---------------------------------------------------------
 // Procedure: generatePath()
+//   Returns: true if a path was built, false if there was nothing
+//            left to plan for.
 
-void GenRescue::generatePath()
+bool GenRescue::generatePath()
 {
   regenerateFlag = false;
   if (pointList.size() == 0) {
     Notify("GENRESCUE_REGENERATE", "finished_mission");
-    return;
+    return(false);
   }
 
   XYSegList seglist;
@@ -262,11 +442,15 @@ void GenRescue::generatePath()
   std::vector<XYPoint> pointList_remaining;
 
   for (size_t i = 0; i < pointList.size(); ++i) {
-    if (pointBool[i]) {
-      pointList_remaining.push_back(pointList[i]);
-    }
+    if (!pointBool[i])
+      continue;
+    if (m_cooperative && !m_claims.ownedBySelf(pointList[i].get_label()))
+      continue;
+    pointList_remaining.push_back(pointList[i]);
   }
 
+  m_tour_len = 0;
+
   while(!pointList_remaining.empty()) {
     double min_dist = numeric_limits<double>::max();
     vector<XYPoint>::iterator nearest_it;
@@ -284,6 +468,7 @@ void GenRescue::generatePath()
     }
 
     seglist.add_vertex(nearest_it->x(), nearest_it->y());
+    m_tour_len += min_dist;
     currPos = *nearest_it;
     pointList_remaining.erase(nearest_it);
   }
@@ -293,7 +478,7 @@ void GenRescue::generatePath()
   // SEND SEGLIST UPDATE
   string update_str = "points = ";
   update_str       += seglist.get_spec();
-  Notify("SURVEY_UPDATE", update_str);
+  notifyCounted("SURVEY_UPDATE", update_str);
 
   NodeMessage node_message;
 
@@ -304,15 +489,41 @@ void GenRescue::generatePath()
 
   string msg = node_message.getSpec();
 
-  Notify("NODE_MESSAGE_LOCAL", msg); 
+  notifyCounted("NODE_MESSAGE_LOCAL", msg);
  
   string spec = seglist.get_spec();
-  Notify("VIEW_SEGLIST", spec);
+  notifyCounted("VIEW_SEGLIST", spec);
 
   Notify("GENRESCUE_REGENERATE", "regenerated_already");
   //Notify("STATION_KEEP", "false");
   //Notify("SURVEY", "true");
   //Notify("RETURN", "false");
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: notifyCounted()
+//   Purpose: Publish a string and tally its payload bytes.
+
+void GenRescue::notifyCounted(const string& var, const string& sval)
+{
+  m_replan_stats.noteBytes(var, sval.size());
+  Notify(var, sval);
+}
+
+//---------------------------------------------------------
+// Procedure: postReplanStats()
+//      Note: The alert latency is only posted for a replan that
+//            picked up a new alert.
+
+void GenRescue::postReplanStats(bool new_alert)
+{
+  double curr_time = MOOSTime();
+  Notify("GENRESCUE_REPLAN_MS", m_replan_stats.getLastReplan() * 1000);
+  Notify("GENRESCUE_REPLAN_STATS", m_replan_stats.getReplanSummary(curr_time));
+  if (new_alert)
+    Notify("GENRESCUE_ALERT_LATENCY", m_replan_stats.getLastLatency());
+  Notify("GENRESCUE_BYTES", m_replan_stats.getBytesSummary());
 }
 
 //------------------------------------------------------------
@@ -321,14 +532,67 @@ void GenRescue::generatePath()
 bool GenRescue::buildReport() 
 {
   m_msgs << "============================================" << endl;
-  m_msgs << "File:                                       " << endl;
+  m_msgs << "pGenRescue Report                           " << endl;
   m_msgs << "============================================" << endl;
 
   ACTable actab(4);
-  actab << "numPoints | m_visit_radius | Charlie | Delta";
+  actab << "Remaining | Known | Visit Radius | Tour Length";
   actab.addHeaderLines();
-  actab << doubleToStringX(numPoints,1) << doubleToStringX(m_visit_radius) << doubleToStringX(pointList.size()) << "four";
+  actab << doubleToStringX(numPoints,1) << doubleToStringX(pointList.size());
+  actab << doubleToStringX(m_visit_radius) << doubleToStringX(m_tour_len, 1);
   m_msgs << actab.getFormattedString();
+  m_msgs << endl << endl;
+
+  double curr_time = MOOSTime();
+  m_msgs << "Replans:" << endl;
+  ACTable rtab(6);
+  rtab << "Count | Min(ms) | Mean(ms) | P99(ms) | Max(ms) | Per Min";
+  rtab.addHeaderLines();
+  rtab << uintToString(m_replan_stats.getReplans());
+  rtab << doubleToStringX(m_replan_stats.getMinReplan() * 1000, 3);
+  rtab << doubleToStringX(m_replan_stats.getMeanReplan() * 1000, 3);
+  rtab << doubleToStringX(m_replan_stats.getPctReplan(99) * 1000, 3);
+  rtab << doubleToStringX(m_replan_stats.getMaxReplan() * 1000, 3);
+  rtab << doubleToStringX(m_replan_stats.getReplansPerMinute(curr_time), 1);
+  m_msgs << rtab.getFormattedString() << endl;
+  m_msgs << "  Alert-to-replan latency: last=";
+  m_msgs << doubleToStringX(m_replan_stats.getLastLatency(), 3) << "s, mean=";
+  m_msgs << doubleToStringX(m_replan_stats.getMeanLatency(), 3) << "s, max=";
+  m_msgs << doubleToStringX(m_replan_stats.getMaxLatency(), 3) << "s" << endl;
+  m_msgs << endl;
+
+  m_msgs << "Bytes Published:" << endl;
+  ACTable btab(2);
+  btab << "Variable | Bytes";
+  btab.addHeaderLines();
+  btab << "NODE_MESSAGE_LOCAL";
+  btab << to_string(m_replan_stats.getBytes("NODE_MESSAGE_LOCAL"));
+  btab << "SURVEY_UPDATE";
+  btab << to_string(m_replan_stats.getBytes("SURVEY_UPDATE"));
+  btab << "VIEW_SEGLIST";
+  btab << to_string(m_replan_stats.getBytes("VIEW_SEGLIST"));
+  m_msgs << btab.getFormattedString() << endl << endl;
+
+  m_msgs << "Swimmer ID History:" << endl;
+  m_msgs << "  Exact ids:   " << m_id_history.sizeRecent();
+  if(m_id_history.getMaxRecent() > 0)
+    m_msgs << " (max " << m_id_history.getMaxRecent() << ")";
+  m_msgs << endl;
+  m_msgs << "  Retired ids: " << m_id_history.sizeRetired();
+  m_msgs << " (bloom bits " << m_id_history.getBloomBits() << ")" << endl;
+  m_msgs << "  Memory:      " << m_id_history.memoryBytes() << " bytes" << endl;
+
+  if(m_cooperative) {
+    m_msgs << endl;
+    m_msgs << "Cooperative Rescue (" << m_hostname << "):" << endl;
+    m_msgs << "  Teammates:      " << m_claims.sizeTeammates(curr_time) << endl;
+    m_msgs << "  Owned:          " << m_claims.sizeOwned(m_hostname) << endl;
+    m_msgs << "  Tour Length:    " << doubleToStringX(m_tour_len, 1) << endl;
+    m_msgs << "  Claims Sent:    " << m_claims.getMsgsSent() << endl;
+    m_msgs << "  Claims Recd:    " << m_claims.getMsgsRecd() << endl;
+    m_msgs << "  Swimmers Given: " << m_claims.getGivesSent() << endl;
+    m_msgs << "  Gives Pending:  " << m_claims.getGivesPending() << endl;
+  }
 
   return(true);
 }
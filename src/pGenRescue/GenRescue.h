@@ -11,6 +11,9 @@
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
 #include "XYPoint.h"
 #include "XYSegList.h"
+#include "SwimmerIdHistory.h"
+#include "RescueClaims.h"
+#include "ReplanStats.h"
 #include <string>
 
 class GenRescue : public AppCastingMOOSApp
@@ -30,17 +33,28 @@ class GenRescue : public AppCastingMOOSApp
 
  protected:
    void registerVariables();
-   void generatePath();
-   void addPoint(std::string report);
+   bool generatePath();
+   bool addPoint(std::string report);
    void removePoint(std::string report);
+   double insertionCost(double x, double y) const;
+   void updateClaims();
+   bool rebalanceClaims();
+   void postClaims();
+   void postReplanStats(bool new_alert);
+   void notifyCounted(const std::string& var, const std::string& sval);
 
  private: // Configuration variables
    double m_visit_radius;
+   bool   m_cooperative;      // plan only over swimmers we have claimed
+   std::string m_claim_var;   // MOOS variable exchanged between rescuers
+   double m_claim_interval;   // seconds between claim broadcasts
+   double m_rebalance_ratio;  // give away a swimmer if tour exceeds this
+                              // multiple of the shortest teammate tour
 
  private: // State variables
    double numPoints;
    std::vector<XYPoint> pointList;
-   std::vector<XYPoint> pointHistory;
+   SwimmerIdHistory m_id_history;  // ids already seen, for dedup
    std::vector<bool> pointBool;
    double navx;
    double navy;
@@ -48,6 +62,13 @@ class GenRescue : public AppCastingMOOSApp
    std::string m_hostname;     // previously set name of ownship
    std::string m_dest_name;    // previously set name of vehicle to communicate
    std::string m_moos_varname; // previously set name of MOOS variable to send
+
+   RescueClaims m_claims;
+   bool   m_claims_dirty;
+   double m_last_claim_time;
+   double m_tour_len;
+
+   ReplanStats m_replan_stats;
 };
 
 #endif 
\ No newline at end of file
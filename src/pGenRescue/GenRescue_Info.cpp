@@ -74,6 +74,18 @@ void showExampleConfigAndExit()
   blk("  AppTick   = 4                                                 ");
   blk("  CommsTick = 4                                                 ");
   blk("                                                                ");
+  blk("  visit_radius       = 5      // meters                         ");
+  blk("                                                                ");
+  blk("  history_max_ids    = 1000   // exact ids kept (0=unbounded)   ");
+  blk("  history_max_age    = 0      // secs until retired (0=never)   ");
+  blk("  history_bloom_bits = 65536  // filter for retired ids (0=off) ");
+  blk("                                                                ");
+  blk("  dest_name       = ben          // recipient of SURVEY_UPDATE  ");
+  blk("  cooperative     = false        // split swimmers by claims    ");
+  blk("  claim_var       = RESCUE_CLAIM                                ");
+  blk("  claim_interval  = 5            // secs between claim posts    ");
+  blk("  rebalance_ratio = 1.5          // tour vs. shortest teammate  ");
+  blk("  teammate_stale  = 30           // secs before claims released ");
   blk("}                                                               ");
   blk("                                                                ");
   exit(0);
@@ -94,12 +106,28 @@ void showInterfaceAndExit()
   blk("                                                                ");
   blk("SUBSCRIPTIONS:                                                  ");
   blk("------------------------------------                            ");
-  blk("  NODE_MESSAGE = src_node=alpha,dest_node=bravo,var_name=FOO,   ");
-  blk("                 string_val=BAR                                 ");
+  blk("  SWIMMER_ALERT = x=12,y=-40,id=7                               ");
+  blk("  FOUND_SWIMMER = id=7                                          ");
+  blk("  NAV_X, NAV_Y  = double                                        ");
+  blk("  GENRESCUE_REGENERATE = regenerate_request                     ");
+  blk("  RESCUE_CLAIM  = vname=abe,x=10,y=-40,tour=231.4,              ");
+  blk("                  own=3:12.4;7:40.2,give=ben:9:33               ");
+  blk("                  (cooperative mode only)                       ");
   blk("                                                                ");
   blk("PUBLICATIONS:                                                   ");
   blk("------------------------------------                            ");
-  blk("  Publications are determined by the node message content.      ");
+  blk("  SURVEY_UPDATE        = points = x1,y1:x2,y2:...               ");
+  blk("  VIEW_SEGLIST         = seglist spec of the planned tour       ");
+  blk("  NODE_MESSAGE_LOCAL   = path for dest_name, and RESCUE_CLAIM   ");
+  blk("                         to all teammates in cooperative mode   ");
+  blk("  GENRESCUE_REGENERATE = regenerated_already, finished_mission  ");
+  blk("  GENRESCUE_REPLAN_MS  = duration of the last replan (ms)       ");
+  blk("  GENRESCUE_REPLAN_STATS = count=12,min_ms=0.4,mean_ms=0.9,     ");
+  blk("                         p99_ms=2.1,max_ms=2.3,per_min=4,       ");
+  blk("                         latency_mean=0.25,max_latency=0.5      ");
+  blk("  GENRESCUE_ALERT_LATENCY = secs from alert to updated plan     ");
+  blk("  GENRESCUE_BYTES      = NODE_MESSAGE_LOCAL=5120,               ");
+  blk("                         SURVEY_UPDATE=2048,VIEW_SEGLIST=1900   ");
   blk("                                                                ");
   exit(0);
 }
@@ -0,0 +1,182 @@
+/************************************************************/
+/*    NAME: Eric Wang                                       */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: ReplanStats.cpp                                 */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#include <algorithm>
+#include "MBUtils.h"
+#include "ReplanStats.h"
+
+using namespace std;
+
+// Number of recent replan durations kept for the percentile estimate
+#define MAX_RECENT_REPLANS 1000
+
+//---------------------------------------------------------
+// Constructor()
+
+ReplanStats::ReplanStats()
+{
+  m_replans       = 0;
+  m_min_replan    = 0;
+  m_max_replan    = 0;
+  m_total_replan  = 0;
+  m_last_replan   = 0;
+  m_recent_ix     = 0;
+
+  m_pending_alert = -1;
+  m_latencies     = 0;
+  m_last_latency  = 0;
+  m_max_latency   = 0;
+  m_total_latency = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: noteAlert()
+//   Purpose: Remember the first alert since the last replan. Later
+//            alerts are served by the same replan.
+
+void ReplanStats::noteAlert(double tstamp)
+{
+  if(m_pending_alert < 0)
+    m_pending_alert = tstamp;
+}
+
+//---------------------------------------------------------
+// Procedure: noteReplan()
+//      Note: elapsed is the duration of the replan in seconds,
+//            tstamp is the MOOS time at which it completed.
+
+bool ReplanStats::noteReplan(double elapsed, double tstamp)
+{
+  if((m_replans == 0) || (elapsed < m_min_replan))
+    m_min_replan = elapsed;
+  if((m_replans == 0) || (elapsed > m_max_replan))
+    m_max_replan = elapsed;
+
+  m_replans++;
+  m_total_replan += elapsed;
+  m_last_replan = elapsed;
+
+  if(m_recent.size() < MAX_RECENT_REPLANS)
+    m_recent.push_back(elapsed);
+  else {
+    m_recent[m_recent_ix] = elapsed;
+    m_recent_ix = (m_recent_ix + 1) % MAX_RECENT_REPLANS;
+  }
+
+  m_replan_times.push_back(tstamp);
+
+  if(m_pending_alert < 0)
+    return(false);
+
+  m_last_latency = tstamp - m_pending_alert;
+  if((m_latencies == 0) || (m_last_latency > m_max_latency))
+    m_max_latency = m_last_latency;
+  m_total_latency += m_last_latency;
+  m_latencies++;
+  m_pending_alert = -1;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: noteBytes()
+
+void ReplanStats::noteBytes(const string& var, unsigned int bytes)
+{
+  m_bytes[var] += bytes;
+}
+
+//---------------------------------------------------------
+// Procedure: getMeanReplan()
+
+double ReplanStats::getMeanReplan() const
+{
+  if(m_replans == 0)
+    return(0);
+  return(m_total_replan / (double)(m_replans));
+}
+
+//---------------------------------------------------------
+// Procedure: getPctReplan()
+//   Purpose: Percentile (0-100) over the most recent replans.
+
+double ReplanStats::getPctReplan(double pct) const
+{
+  if(m_recent.empty())
+    return(0);
+
+  vector<double> vals = m_recent;
+  unsigned int ix = (unsigned int)((pct / 100.0) * (vals.size() - 1) + 0.5);
+  if(ix >= vals.size())
+    ix = vals.size() - 1;
+  nth_element(vals.begin(), vals.begin() + ix, vals.end());
+  return(vals[ix]);
+}
+
+//---------------------------------------------------------
+// Procedure: getReplansPerMinute()
+
+double ReplanStats::getReplansPerMinute(double curr_time)
+{
+  while(!m_replan_times.empty() && ((curr_time - m_replan_times.front()) > 60))
+    m_replan_times.pop_front();
+  return((double)(m_replan_times.size()));
+}
+
+//---------------------------------------------------------
+// Procedure: getMeanLatency()
+
+double ReplanStats::getMeanLatency() const
+{
+  if(m_latencies == 0)
+    return(0);
+  return(m_total_latency / (double)(m_latencies));
+}
+
+//---------------------------------------------------------
+// Procedure: getBytes()
+
+unsigned long int ReplanStats::getBytes(const string& var) const
+{
+  map<string, unsigned long int>::const_iterator p = m_bytes.find(var);
+  if(p == m_bytes.end())
+    return(0);
+  return(p->second);
+}
+
+//---------------------------------------------------------
+// Procedure: getReplanSummary()
+//   Example: count=12,min_ms=0.41,mean_ms=0.88,p99_ms=2.1,max_ms=2.3,
+//            per_min=4,latency_mean=0.25,max_latency=0.5
+
+string ReplanStats::getReplanSummary(double curr_time)
+{
+  string str = "count=" + uintToString(m_replans);
+  str += ",min_ms="  + doubleToStringX(m_min_replan * 1000, 3);
+  str += ",mean_ms=" + doubleToStringX(getMeanReplan() * 1000, 3);
+  str += ",p99_ms="  + doubleToStringX(getPctReplan(99) * 1000, 3);
+  str += ",max_ms="  + doubleToStringX(m_max_replan * 1000, 3);
+  str += ",per_min=" + doubleToStringX(getReplansPerMinute(curr_time), 1);
+  str += ",latency_mean=" + doubleToStringX(getMeanLatency(), 3);
+  str += ",max_latency=" + doubleToStringX(m_max_latency, 3);
+  return(str);
+}
+
+//---------------------------------------------------------
+// Procedure: getBytesSummary()
+//   Example: NODE_MESSAGE_LOCAL=5120,SURVEY_UPDATE=2048
+
+string ReplanStats::getBytesSummary() const
+{
+  string str;
+  map<string, unsigned long int>::const_iterator p;
+  for(p=m_bytes.begin(); p!=m_bytes.end(); p++) {
+    if(str != "")
+      str += ",";
+    str += p->first + "=" + to_string(p->second);
+  }
+  return(str);
+}
@@ -0,0 +1,75 @@
+/************************************************************/
+/*    NAME: Eric Wang                                       */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: ReplanStats.h                                   */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef REPLAN_STATS_HEADER
+#define REPLAN_STATS_HEADER
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+
+// Bookkeeping for pGenRescue replans: how long each generatePath()
+// took, how often it runs, how long after an alert the plan caught
+// up, and how many bytes each published variable has carried.
+
+class ReplanStats
+{
+ public:
+  ReplanStats();
+  ~ReplanStats() {};
+
+  void noteAlert(double tstamp);
+  // Returns true if the replan picked up a pending alert
+  bool noteReplan(double elapsed, double tstamp);
+  void noteBytes(const std::string& var, unsigned int bytes);
+
+  unsigned int getReplans() const     {return(m_replans);};
+  double getMinReplan() const         {return(m_min_replan);};
+  double getMaxReplan() const         {return(m_max_replan);};
+  double getMeanReplan() const;
+  double getPctReplan(double pct) const;
+  double getLastReplan() const        {return(m_last_replan);};
+  double getReplansPerMinute(double curr_time);
+
+  unsigned int getLatencies() const   {return(m_latencies);};
+  double getLastLatency() const       {return(m_last_latency);};
+  double getMeanLatency() const;
+  double getMaxLatency() const        {return(m_max_latency);};
+
+  unsigned long int getBytes(const std::string& var) const;
+  const std::map<std::string, unsigned long int>& getByteMap() const
+    {return(m_bytes);};
+
+  std::string getReplanSummary(double curr_time);
+  std::string getBytesSummary() const;
+
+ private: // State variables
+  unsigned int m_replans;
+  double       m_min_replan;
+  double       m_max_replan;
+  double       m_total_replan;
+  double       m_last_replan;
+
+  // Most recent replan durations, used for the percentile estimate
+  std::vector<double> m_recent;
+  unsigned int        m_recent_ix;
+
+  // Replan timestamps within the last minute
+  std::deque<double> m_replan_times;
+
+  // Time of the oldest alert not yet reflected in a plan, -1 if none
+  double       m_pending_alert;
+  unsigned int m_latencies;
+  double       m_last_latency;
+  double       m_max_latency;
+  double       m_total_latency;
+
+  std::map<std::string, unsigned long int> m_bytes;
+};
+
+#endif
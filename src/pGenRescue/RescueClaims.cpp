@@ -0,0 +1,349 @@
+/************************************************************/
+/*    NAME: Eric Wang                                       */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: RescueClaims.cpp                                */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#include <cstdlib>
+#include <cmath>
+#include "MBUtils.h"
+#include "RescueClaims.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Procedure: roundCost()
+//   Purpose: Costs go out with one decimal. Local costs are rounded
+//            the same way so both sides compare identical values, and
+//            exact ties fall to the vehicle name.
+
+static double roundCost(double cost)
+{
+  return(floor(cost * 10 + 0.5) / 10);
+}
+
+//---------------------------------------------------------
+// Constructor()
+
+RescueClaims::RescueClaims()
+{
+  m_stale_thresh = 30;
+
+  m_msgs_recd  = 0;
+  m_msgs_sent  = 0;
+  m_gives_sent = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: setStaleThresh()
+
+bool RescueClaims::setStaleThresh(double secs)
+{
+  if(secs <= 0)
+    return(false);
+  m_stale_thresh = secs;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: claimOwn()
+//   Returns: true if we own the swimmer after the claim.
+
+bool RescueClaims::claimOwn(const string& id, double cost)
+{
+  applyClaim(id, m_own_name, cost, m_own_name);
+  return(ownedBySelf(id));
+}
+
+//---------------------------------------------------------
+// Procedure: giveTo()
+//   Purpose: Hand one of our swimmers to a teammate. The transfer
+//            goes out with every claim message until confirmed.
+
+bool RescueClaims::giveTo(const string& id, const string& vname, double cost,
+                          double curr_time)
+{
+  if(!ownedBySelf(id) || (vname == m_own_name))
+    return(false);
+
+  cost = roundCost(cost);
+  m_claims[id].owner = vname;
+  m_claims[id].cost  = cost;
+
+  Give give;
+  give.to     = vname;
+  give.cost   = cost;
+  give.tstamp = curr_time;
+  m_pending_gives[id] = give;
+  m_gives_sent++;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: removeSwimmer()
+
+void RescueClaims::removeSwimmer(const string& id)
+{
+  m_claims.erase(id);
+  m_pending_gives.erase(id);
+}
+
+//---------------------------------------------------------
+// Procedure: applyClaim()
+//   Returns: true if the owner of the swimmer changed.
+
+bool RescueClaims::applyClaim(const string& id, const string& owner,
+                              double cost, const string& sender)
+{
+  cost = roundCost(cost);
+
+  map<string, Claim>::iterator p = m_claims.find(id);
+  if(p == m_claims.end()) {
+    Claim claim;
+    claim.owner = owner;
+    claim.cost  = cost;
+    m_claims[id] = claim;
+    return(true);
+  }
+
+  Claim& claim = p->second;
+
+  bool accept = false;
+  if((claim.owner == "") || (claim.owner == sender))
+    accept = true;
+  else if(cost < claim.cost)
+    accept = true;
+  else if((cost == claim.cost) && (owner < claim.owner))
+    accept = true;
+
+  if(!accept)
+    return(false);
+
+  bool changed = (claim.owner != owner);
+  claim.owner = owner;
+  claim.cost  = cost;
+  return(changed);
+}
+
+//---------------------------------------------------------
+// Procedure: handleClaimMsg()
+
+bool RescueClaims::handleClaimMsg(const string& msg, double curr_time)
+{
+  string sender;
+  string own_str;
+  string give_str;
+  Teammate mate;
+  mate.x = 0;
+  mate.y = 0;
+  mate.tour_len = 0;
+  mate.tstamp = curr_time;
+
+  vector<string> svector = parseString(msg, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string value = svector[i];
+    string param = biteStringX(value, '=');
+    if(param == "vname")
+      sender = value;
+    else if(param == "x")
+      mate.x = atof(value.c_str());
+    else if(param == "y")
+      mate.y = atof(value.c_str());
+    else if(param == "tour")
+      mate.tour_len = atof(value.c_str());
+    else if(param == "own")
+      own_str = value;
+    else if(param == "give")
+      give_str = value;
+  }
+
+  if((sender == "") || (sender == m_own_name))
+    return(false);
+
+  m_teammates[sender] = mate;
+  m_msgs_recd++;
+
+  bool changed = false;
+
+  vector<string> own_vector = parseString(own_str, ';');
+  for(unsigned int i=0; i<own_vector.size(); i++) {
+    string cost = own_vector[i];
+    string id   = biteStringX(cost, ':');
+
+    // The receiver of a pending give now lists it, so stop sending it
+    map<string, Give>::iterator g = m_pending_gives.find(id);
+    if((g != m_pending_gives.end()) && (g->second.to == sender))
+      m_pending_gives.erase(g);
+
+    bool was_ours = ownedBySelf(id);
+    applyClaim(id, sender, atof(cost.c_str()), sender);
+    if(was_ours != ownedBySelf(id))
+      changed = true;
+  }
+
+  vector<string> give_vector = parseString(give_str, ';');
+  for(unsigned int i=0; i<give_vector.size(); i++) {
+    string cost  = give_vector[i];
+    string owner = biteStringX(cost, ':');
+    string id    = biteStringX(cost, ':');
+    bool was_ours = ownedBySelf(id);
+    applyClaim(id, owner, atof(cost.c_str()), sender);
+    if(was_ours != ownedBySelf(id))
+      changed = true;
+  }
+
+  return(changed);
+}
+
+//---------------------------------------------------------
+// Procedure: getClaimMsg()
+//   Purpose: Build the full claim message for ownship, repeating
+//            any gives not yet confirmed by their receiver.
+
+string RescueClaims::getClaimMsg(double osx, double osy, double tour_len)
+{
+  string own_str;
+  map<string, Claim>::iterator p;
+  for(p=m_claims.begin(); p!=m_claims.end(); p++) {
+    if(p->second.owner != m_own_name)
+      continue;
+    if(own_str != "")
+      own_str += ";";
+    own_str += p->first + ":" + doubleToStringX(p->second.cost, 1);
+  }
+
+  string msg = "vname=" + m_own_name;
+  msg += ",x=" + doubleToStringX(osx, 1);
+  msg += ",y=" + doubleToStringX(osy, 1);
+  msg += ",tour=" + doubleToStringX(tour_len, 1);
+  if(own_str != "")
+    msg += ",own=" + own_str;
+
+  string give_str;
+  map<string, Give>::iterator g;
+  for(g=m_pending_gives.begin(); g!=m_pending_gives.end(); g++) {
+    if(give_str != "")
+      give_str += ";";
+    give_str += g->second.to + ":" + g->first + ":" + doubleToStringX(g->second.cost, 1);
+  }
+  if(give_str != "")
+    msg += ",give=" + give_str;
+
+  m_msgs_sent++;
+  return(msg);
+}
+
+//---------------------------------------------------------
+// Procedure: releaseStale()
+//   Purpose: Drop teammates we have not heard from recently and
+//            return the ids they owned so ownship can bid on them.
+//            Gives never confirmed by their receiver are released
+//            the same way.
+
+vector<string> RescueClaims::releaseStale(double curr_time)
+{
+  vector<string> released;
+
+  map<string, Give>::iterator g = m_pending_gives.begin();
+  while(g != m_pending_gives.end()) {
+    if((curr_time - g->second.tstamp) <= m_stale_thresh) {
+      ++g;
+      continue;
+    }
+    map<string, Claim>::iterator p = m_claims.find(g->first);
+    if((p != m_claims.end()) && (p->second.owner == g->second.to)) {
+      p->second.owner = "";
+      released.push_back(g->first);
+    }
+    m_pending_gives.erase(g++);
+  }
+
+  map<string, Teammate>::iterator q = m_teammates.begin();
+  while(q != m_teammates.end()) {
+    if((curr_time - q->second.tstamp) <= m_stale_thresh) {
+      ++q;
+      continue;
+    }
+    map<string, Claim>::iterator p;
+    for(p=m_claims.begin(); p!=m_claims.end(); p++) {
+      if(p->second.owner == q->first) {
+        p->second.owner = "";
+        released.push_back(p->first);
+      }
+    }
+    m_teammates.erase(q++);
+  }
+  return(released);
+}
+
+//---------------------------------------------------------
+// Procedure: ownedBySelf()
+
+bool RescueClaims::ownedBySelf(const string& id) const
+{
+  return(getOwner(id) == m_own_name);
+}
+
+//---------------------------------------------------------
+// Procedure: getOwner()
+
+string RescueClaims::getOwner(const string& id) const
+{
+  map<string, Claim>::const_iterator p = m_claims.find(id);
+  if(p == m_claims.end())
+    return("");
+  return(p->second.owner);
+}
+
+//---------------------------------------------------------
+// Procedure: getShortestTeammate()
+//   Purpose: Find the live teammate with the shortest reported tour.
+
+bool RescueClaims::getShortestTeammate(double curr_time, string& vname,
+                                       double& x, double& y,
+                                       double& tour_len) const
+{
+  bool found = false;
+  map<string, Teammate>::const_iterator q;
+  for(q=m_teammates.begin(); q!=m_teammates.end(); q++) {
+    if((curr_time - q->second.tstamp) > m_stale_thresh)
+      continue;
+    if(!found || (q->second.tour_len < tour_len)) {
+      found    = true;
+      vname    = q->first;
+      x        = q->second.x;
+      y        = q->second.y;
+      tour_len = q->second.tour_len;
+    }
+  }
+  return(found);
+}
+
+//---------------------------------------------------------
+// Procedure: sizeOwned()
+
+unsigned int RescueClaims::sizeOwned(const string& vname) const
+{
+  unsigned int total = 0;
+  map<string, Claim>::const_iterator p;
+  for(p=m_claims.begin(); p!=m_claims.end(); p++) {
+    if(p->second.owner == vname)
+      total++;
+  }
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: sizeTeammates()
+
+unsigned int RescueClaims::sizeTeammates(double curr_time) const
+{
+  unsigned int total = 0;
+  map<string, Teammate>::const_iterator q;
+  for(q=m_teammates.begin(); q!=m_teammates.end(); q++) {
+    if((curr_time - q->second.tstamp) <= m_stale_thresh)
+      total++;
+  }
+  return(total);
+}
@@ -0,0 +1,100 @@
+/************************************************************/
+/*    NAME: Eric Wang                                       */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: RescueClaims.h                                  */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef RESCUE_CLAIMS_HEADER
+#define RESCUE_CLAIMS_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+
+// Shared swimmer ownership for cooperative rescue. Every vehicle keeps
+// the same table of swimmer id -> (owner, cost) and converges on it by
+// exchanging claim messages of the form:
+//
+//   vname=abe,x=10.5,y=-40,tour=231.4,own=3:12.4;7:40.2,give=ben:9:33
+//
+// Costs are kept rounded to the one decimal they are sent with, so
+// every vehicle compares the same values. A claim replaces the current
+// owner if it is cheaper, if it ties and the owner name sorts first,
+// or if it comes from the current owner (which is how an owner updates
+// its cost or hands a swimmer to a teammate with "give"). A give is
+// repeated in every claim message until the receiver lists the
+// swimmer in its own "own" list. If that does not happen within the
+// stale threshold the giver takes the swimmer back.
+
+class RescueClaims
+{
+ public:
+  RescueClaims();
+  ~RescueClaims() {};
+
+  void setOwnName(std::string vname)  {m_own_name = vname;};
+  bool setStaleThresh(double secs);
+
+  // Local events
+  bool claimOwn(const std::string& id, double cost);
+  bool giveTo(const std::string& id, const std::string& vname, double cost,
+              double curr_time);
+  void removeSwimmer(const std::string& id);
+
+  // Remote events. Returns true if our own set of swimmers changed.
+  bool handleClaimMsg(const std::string& msg, double curr_time);
+
+  std::string getClaimMsg(double osx, double osy, double tour_len);
+  std::vector<std::string> releaseStale(double curr_time);
+
+  bool ownedBySelf(const std::string& id) const;
+  std::string getOwner(const std::string& id) const;
+  bool getShortestTeammate(double curr_time, std::string& vname,
+                           double& x, double& y, double& tour_len) const;
+
+  unsigned int sizeOwned(const std::string& vname) const;
+  unsigned int sizeTeammates(double curr_time) const;
+  unsigned int getMsgsRecd() const  {return(m_msgs_recd);};
+  unsigned int getMsgsSent() const  {return(m_msgs_sent);};
+  unsigned int getGivesSent() const {return(m_gives_sent);};
+  unsigned int getGivesPending() const {return(m_pending_gives.size());};
+
+ protected:
+  bool applyClaim(const std::string& id, const std::string& owner,
+                  double cost, const std::string& sender);
+
+ private:
+  struct Claim {
+    std::string owner;
+    double      cost;
+  };
+
+  struct Give {
+    std::string to;
+    double      cost;
+    double      tstamp;
+  };
+
+  struct Teammate {
+    double x;
+    double y;
+    double tour_len;
+    double tstamp;
+  };
+
+ private: // Configuration variables
+  std::string m_own_name;
+  double      m_stale_thresh;
+
+ private: // State variables
+  std::map<std::string, Claim>    m_claims;
+  std::map<std::string, Teammate> m_teammates;
+  std::map<std::string, Give>     m_pending_gives;
+
+  unsigned int m_msgs_recd;
+  unsigned int m_msgs_sent;
+  unsigned int m_gives_sent;
+};
+
+#endif
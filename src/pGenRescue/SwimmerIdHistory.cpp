@@ -0,0 +1,202 @@
+/************************************************************/
+/*    NAME: Eric Wang                                       */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: SwimmerIdHistory.cpp                            */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#include <functional>
+#include "SwimmerIdHistory.h"
+
+using namespace std;
+
+// Number of hash probes per id in the Bloom filter
+#define BLOOM_HASHES 4
+
+//---------------------------------------------------------
+// Constructor()
+
+SwimmerIdHistory::SwimmerIdHistory()
+{
+  m_max_recent = 1000;
+  m_max_age    = 0;
+  m_bloom_bits = 0;
+  m_retired    = 0;
+  m_id_chars   = 0;
+
+  setBloomBits(65536);
+}
+
+//---------------------------------------------------------
+// Procedure: setMaxRecent()
+
+bool SwimmerIdHistory::setMaxRecent(unsigned int amt)
+{
+  m_max_recent = amt;
+  while((m_max_recent > 0) && (m_recent_order.size() > m_max_recent))
+    retireOldest();
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: setMaxAge()
+
+bool SwimmerIdHistory::setMaxAge(double secs)
+{
+  if(secs < 0)
+    return(false);
+  m_max_age = secs;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: setBloomBits()
+//      Note: The filter is rounded up to a whole number of 64-bit
+//            words. Resizing clears any ids already retired.
+
+bool SwimmerIdHistory::setBloomBits(unsigned int bits)
+{
+  unsigned int words = (bits + 63) / 64;
+  m_bloom_bits = words * 64;
+  m_bloom.assign(words, 0);
+  m_retired = 0;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: contains()
+
+bool SwimmerIdHistory::contains(const string& id) const
+{
+  if(m_recent_ids.count(id))
+    return(true);
+  if(m_retired == 0)
+    return(false);
+  return(bloomContains(id));
+}
+
+//---------------------------------------------------------
+// Procedure: add()
+
+void SwimmerIdHistory::add(const string& id, double tstamp)
+{
+  if(!m_recent_ids.insert(id).second)
+    return;
+
+  m_recent_order.push_back(make_pair(id, tstamp));
+  m_id_chars += id.size();
+
+  if((m_max_recent > 0) && (m_recent_order.size() > m_max_recent))
+    retireOldest();
+}
+
+//---------------------------------------------------------
+// Procedure: prune()
+//   Purpose: Retire exact entries older than the configured max age.
+
+void SwimmerIdHistory::prune(double curr_time)
+{
+  if(m_max_age <= 0)
+    return;
+
+  while(!m_recent_order.empty() &&
+        ((curr_time - m_recent_order.front().second) > m_max_age))
+    retireOldest();
+}
+
+//---------------------------------------------------------
+// Procedure: clear()
+
+void SwimmerIdHistory::clear()
+{
+  m_recent_ids.clear();
+  m_recent_order.clear();
+  m_bloom.assign(m_bloom.size(), 0);
+  m_retired  = 0;
+  m_id_chars = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: memoryBytes()
+//   Purpose: Approximate heap footprint of the history. Each exact
+//            id is held once in the hash set and once in the age
+//            queue, plus per-node and per-bucket overhead.
+
+unsigned int SwimmerIdHistory::memoryBytes() const
+{
+  unsigned int node_bytes = sizeof(void*) + sizeof(string) + sizeof(size_t);
+  unsigned int ordr_bytes = sizeof(pair<string, double>);
+
+  unsigned int total = 0;
+  total += m_recent_ids.size() * node_bytes;
+  total += m_recent_ids.bucket_count() * sizeof(void*);
+  total += m_recent_order.size() * ordr_bytes;
+  total += 2 * m_id_chars;
+  total += m_bloom.size() * sizeof(unsigned long long);
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: retireOldest()
+
+void SwimmerIdHistory::retireOldest()
+{
+  if(m_recent_order.empty())
+    return;
+
+  const string& id = m_recent_order.front().first;
+  if(m_bloom_bits > 0) {
+    bloomInsert(id);
+    m_retired++;
+  }
+  m_recent_ids.erase(id);
+  m_id_chars -= id.size();
+  m_recent_order.pop_front();
+}
+
+//---------------------------------------------------------
+// Procedure: bloomIndices()
+//   Purpose: Derive the probe positions by double hashing, with
+//            std::hash as the base and FNV-1a as the stride.
+
+void SwimmerIdHistory::bloomIndices(const string& id, unsigned int ix[]) const
+{
+  unsigned long long h1 = hash<string>()(id);
+  unsigned long long h2 = 14695981039346656037ULL;
+  for(unsigned int i=0; i<id.size(); i++) {
+    h2 ^= (unsigned char)(id[i]);
+    h2 *= 1099511628211ULL;
+  }
+  h2 |= 1;
+
+  for(unsigned int i=0; i<BLOOM_HASHES; i++)
+    ix[i] = (unsigned int)((h1 + i * h2) % m_bloom_bits);
+}
+
+//---------------------------------------------------------
+// Procedure: bloomInsert()
+
+void SwimmerIdHistory::bloomInsert(const string& id)
+{
+  unsigned int ix[BLOOM_HASHES];
+  bloomIndices(id, ix);
+  for(unsigned int i=0; i<BLOOM_HASHES; i++)
+    m_bloom[ix[i] / 64] |= (1ULL << (ix[i] % 64));
+}
+
+//---------------------------------------------------------
+// Procedure: bloomContains()
+
+bool SwimmerIdHistory::bloomContains(const string& id) const
+{
+  if(m_bloom_bits == 0)
+    return(false);
+
+  unsigned int ix[BLOOM_HASHES];
+  bloomIndices(id, ix);
+  for(unsigned int i=0; i<BLOOM_HASHES; i++) {
+    if((m_bloom[ix[i] / 64] & (1ULL << (ix[i] % 64))) == 0)
+      return(false);
+  }
+  return(true);
+}
@@ -0,0 +1,65 @@
+/************************************************************/
+/*    NAME: Eric Wang                                       */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: SwimmerIdHistory.h                              */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef SWIMMER_ID_HISTORY_HEADER
+#define SWIMMER_ID_HISTORY_HEADER
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_set>
+
+// Remembers which swimmer ids have already been seen. Recent ids are
+// kept exactly, bounded by count and/or age. Ids that fall out of the
+// exact set are retired into a fixed-size Bloom filter so that a
+// re-broadcast alert for an old swimmer is still (probabilistically)
+// recognized without memory growing over the mission.
+
+class SwimmerIdHistory
+{
+ public:
+  SwimmerIdHistory();
+  ~SwimmerIdHistory() {};
+
+  bool setMaxRecent(unsigned int amt);
+  bool setMaxAge(double secs);
+  bool setBloomBits(unsigned int bits);
+
+  bool contains(const std::string& id) const;
+  void add(const std::string& id, double tstamp);
+  void prune(double curr_time);
+  void clear();
+
+  unsigned int getMaxRecent() const  {return(m_max_recent);};
+  double       getMaxAge() const     {return(m_max_age);};
+  unsigned int getBloomBits() const  {return(m_bloom_bits);};
+
+  unsigned int sizeRecent() const    {return(m_recent_ids.size());};
+  unsigned int sizeRetired() const   {return(m_retired);};
+  unsigned int memoryBytes() const;
+
+ protected:
+  void retireOldest();
+  void bloomInsert(const std::string& id);
+  bool bloomContains(const std::string& id) const;
+  void bloomIndices(const std::string& id, unsigned int ix[]) const;
+
+ private: // Configuration variables
+  unsigned int m_max_recent;   // 0 means unbounded
+  double       m_max_age;      // seconds, 0 means never expire
+  unsigned int m_bloom_bits;   // 0 means retired ids are forgotten
+
+ private: // State variables
+  std::unordered_set<std::string> m_recent_ids;
+  std::deque<std::pair<std::string, double> > m_recent_order;
+  std::vector<unsigned long long> m_bloom;
+
+  unsigned int m_retired;
+  unsigned int m_id_chars;
+};
+
+#endif
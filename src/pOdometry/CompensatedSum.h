@@ -0,0 +1,40 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: CompensatedSum.h                                */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef COMPENSATED_SUM_HEADER
+#define COMPENSATED_SUM_HEADER
+
+#include <cmath>
+
+// Neumaier (improved Kahan) summation. The low-order bits lost on each
+// add are carried in m_comp and folded back in on get(), so summing
+// millions of small steps onto a large total loses next to nothing.
+// Both error terms are computed and one selected, which compiles to a
+// blend rather than a branch. Must not be built with -ffast-math.
+
+class CompensatedSum
+{
+ public:
+  CompensatedSum() : m_sum(0), m_comp(0) {};
+
+  void add(double val) {
+    double total = m_sum + val;
+    double err_big_sum = (m_sum - total) + val;
+    double err_big_val = (val - total) + m_sum;
+    m_comp += (fabs(m_sum) >= fabs(val)) ? err_big_sum : err_big_val;
+    m_sum = total;
+  }
+
+  double get() const  {return(m_sum + m_comp);};
+  void   reset()      {m_sum = 0; m_comp = 0;};
+
+ private:
+  double m_sum;
+  double m_comp;
+};
+
+#endif
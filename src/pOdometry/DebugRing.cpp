@@ -0,0 +1,212 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: DebugRing.cpp                                   */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#include <cstdio>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include "MBUtils.h"
+#include "DebugRing.h"
+
+using namespace std;
+
+// The crash handler can only reach the log through globals
+static const DebugRing* g_crash_ring = 0;
+static char g_crash_file[512];
+
+static const char* g_level_names[] = {"ERROR", "WARN ", "INFO ", "DEBUG"};
+
+// dump() builds its lines by hand: printf and friends are not
+// async-signal-safe. Text that does not fit in a line is dropped.
+static const unsigned int LINE_SIZE = 256;
+
+static void appendStr(char* line, unsigned int& len, const char* str)
+{
+  while(*str && (len < LINE_SIZE))
+    line[len++] = *str++;
+}
+
+static void appendUInt(char* line, unsigned int& len, unsigned long long val,
+                       unsigned int min_digits=1)
+{
+  char digits[24];
+  unsigned int n = 0;
+  while((n < min_digits) || (val > 0)) {
+    digits[n++] = '0' + (val % 10);
+    val /= 10;
+  }
+  while((n > 0) && (len < LINE_SIZE))
+    line[len++] = digits[--n];
+}
+
+// Fixed point with three decimals, or d.ddde<exp> for large values
+static void appendDouble(char* line, unsigned int& len, double val)
+{
+  if(val != val) {
+    appendStr(line, len, "nan");
+    return;
+  }
+  if(val < 0) {
+    appendStr(line, len, "-");
+    val = -val;
+  }
+  if(val > 1.7976931348623157e308) {
+    appendStr(line, len, "inf");
+    return;
+  }
+
+  unsigned int exp10 = 0;
+  if(val >= 1e15) {
+    while(val >= 10) {
+      val /= 10;
+      exp10++;
+    }
+  }
+
+  unsigned long long whole = (unsigned long long)val;
+  unsigned long long frac  = (unsigned long long)((val - whole) * 1000 + 0.5);
+  if(frac >= 1000) {
+    whole++;
+    frac -= 1000;
+  }
+  appendUInt(line, len, whole);
+  appendStr(line, len, ".");
+  appendUInt(line, len, frac, 3);
+  if(exp10 > 0) {
+    appendStr(line, len, "e");
+    appendUInt(line, len, exp10);
+  }
+}
+
+//---------------------------------------------------------
+// Constructor()
+
+DebugRing::DebugRing()
+{
+  m_count = 0;
+  m_level = DBG_INFO;
+  for(unsigned int i=0; i<CAPACITY; i++) {
+    m_entries[i].seq   = 0;
+    m_entries[i].time  = 0;
+    m_entries[i].msg   = 0;
+    m_entries[i].val   = 0;
+    m_entries[i].level = 0;
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: setLevel()
+
+bool DebugRing::setLevel(string level)
+{
+  level = tolower(level);
+  if(level == "error")
+    m_level = DBG_ERROR;
+  else if(level == "warn")
+    m_level = DBG_WARN;
+  else if(level == "info")
+    m_level = DBG_INFO;
+  else if(level == "debug")
+    m_level = DBG_DEBUG;
+  else
+    return(false);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: dump()
+//   Purpose: Write the log using only write() and the formatting
+//            above, so this can be called from a signal handler.
+//            An entry being overwritten as it is read is skipped.
+
+void DebugRing::dump(int fd) const
+{
+  unsigned long last  = m_count.load(std::memory_order_relaxed);
+  unsigned long first = (last > CAPACITY) ? last - CAPACITY : 0;
+
+  char line[LINE_SIZE + 1];
+  unsigned int len = 0;
+  appendStr(line, len, "--- pOdometry debug log: ");
+  appendUInt(line, len, last - first);
+  appendStr(line, len, " of ");
+  appendUInt(line, len, last);
+  appendStr(line, len, " entries ---");
+  line[len++] = '\n';
+  if(write(fd, line, len) < 0)
+    return;
+
+  for(unsigned long n=first; n<last; n++) {
+    const Entry& entry = m_entries[n & (CAPACITY - 1)];
+    if(entry.seq.load(std::memory_order_acquire) != n + 1)
+      continue;
+    double      time  = entry.time;
+    const char* msg   = entry.msg;
+    double      val   = entry.val;
+    int         level = entry.level;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(entry.seq.load(std::memory_order_relaxed) != n + 1)
+      continue;
+
+    if((level < DBG_ERROR) || (level > DBG_DEBUG))
+      level = DBG_DEBUG;
+    len = 0;
+    appendDouble(line, len, time);
+    appendStr(line, len, " ");
+    appendStr(line, len, g_level_names[level]);
+    appendStr(line, len, " ");
+    appendStr(line, len, msg);
+    appendStr(line, len, " ");
+    appendDouble(line, len, val);
+    line[len++] = '\n';
+    if(write(fd, line, len) < 0)
+      return;
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: dumpToFile()
+
+bool DebugRing::dumpToFile(const string& filename) const
+{
+  int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if(fd < 0)
+    return(false);
+  dump(fd);
+  close(fd);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: crashHandler()
+
+static void crashHandler(int sig)
+{
+  if(g_crash_ring) {
+    g_crash_ring->dump(STDERR_FILENO);
+    int fd = open(g_crash_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd >= 0) {
+      g_crash_ring->dump(fd);
+      close(fd);
+    }
+  }
+  signal(sig, SIG_DFL);
+  raise(sig);
+}
+
+//---------------------------------------------------------
+// Procedure: installCrashDump()
+
+void DebugRing::installCrashDump(const string& filename)
+{
+  snprintf(g_crash_file, sizeof(g_crash_file), "%s", filename.c_str());
+  g_crash_ring = this;
+
+  signal(SIGSEGV, crashHandler);
+  signal(SIGBUS,  crashHandler);
+  signal(SIGFPE,  crashHandler);
+  signal(SIGABRT, crashHandler);
+}
@@ -0,0 +1,76 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: DebugRing.h                                     */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef DEBUG_RING_HEADER
+#define DEBUG_RING_HEADER
+
+#include <atomic>
+#include <string>
+
+// In-memory debug log of the most recent entries. Logging an entry is
+// a level check, one atomic increment and a few stores, with no
+// allocation, locking or I/O, so it is safe to leave on the per
+// message path. Each slot carries the sequence number of the entry in
+// it, so concurrent writers can share the log and dump() skips a slot
+// caught mid-write. Messages must be string literals: only the
+// pointer is kept. The log is written out only when dump() is called,
+// which formats numbers by hand and calls only write(), so it may be
+// used from a signal handler.
+
+enum DebugLevel {DBG_ERROR=0, DBG_WARN=1, DBG_INFO=2, DBG_DEBUG=3};
+
+class DebugRing
+{
+ public:
+  DebugRing();
+  ~DebugRing() {};
+
+  bool setLevel(std::string level);
+  int  getLevel() const {return(m_level);};
+
+  void log(int level, double time, const char* msg, double val=0)
+  {
+    if(level > m_level)
+      return;
+    unsigned long n = m_count.fetch_add(1, std::memory_order_relaxed);
+    Entry& entry = m_entries[n & (CAPACITY - 1)];
+    entry.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.time  = time;
+    entry.msg   = msg;
+    entry.val   = val;
+    entry.level = level;
+    entry.seq.store(n + 1, std::memory_order_release);
+  }
+
+  // Write the entries, oldest first, to an open file descriptor
+  void dump(int fd) const;
+  bool dumpToFile(const std::string& filename) const;
+
+  unsigned long getCount() const {return(m_count.load(std::memory_order_relaxed));};
+
+  // Dump to the given file (and stderr) on SIGSEGV, SIGBUS, SIGFPE
+  // or SIGABRT, then let the signal take its usual course.
+  void installCrashDump(const std::string& filename);
+
+ private:
+  static const unsigned int CAPACITY = 1024;   // a power of two
+
+  struct Entry {
+    std::atomic<unsigned long> seq;    // entry number + 1, 0 while written
+    double      time;
+    const char* msg;
+    double      val;
+    int         level;
+  };
+
+  Entry m_entries[CAPACITY];
+  std::atomic<unsigned long> m_count;
+  int m_level;
+};
+
+#endif
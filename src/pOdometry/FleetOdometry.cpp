@@ -0,0 +1,174 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: FleetOdometry.cpp                               */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <cctype>
+#include "MBUtils.h"
+#include "FleetOdometry.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Constructor()
+
+FleetOdometry::FleetOdometry()
+{
+  m_depth_thresh = 999999999;
+  m_noise_floor  = 0;
+  m_reports  = 0;
+  m_rejected = 0;
+  m_stale    = 0;
+  reserve(128);
+}
+
+//---------------------------------------------------------
+// Procedure: reserve()
+
+void FleetOdometry::reserve(unsigned int vehicles)
+{
+  m_index.reserve(vehicles);
+  m_names.reserve(vehicles);
+  m_tracks.reserve(vehicles);
+  m_times.reserve(vehicles);
+}
+
+//---------------------------------------------------------
+// Procedure: setDepthThresh()
+
+void FleetOdometry::setDepthThresh(double depth)
+{
+  m_depth_thresh = depth;
+  for(unsigned int i=0; i<m_tracks.size(); i++)
+    m_tracks[i].setDepthThresh(depth);
+}
+
+//---------------------------------------------------------
+// Procedure: setNoiseFloor()
+
+void FleetOdometry::setNoiseFloor(double floor)
+{
+  m_noise_floor = floor;
+  for(unsigned int i=0; i<m_tracks.size(); i++)
+    m_tracks[i].setNoiseFloor(floor);
+}
+
+//---------------------------------------------------------
+// Procedure: vehicleIndex()
+//   Purpose: Find or add the vehicle. Names are case-insensitive.
+
+unsigned int FleetOdometry::vehicleIndex(const char* name, unsigned int len)
+{
+  m_key.assign(name, len);
+  for(unsigned int i=0; i<len; i++)
+    m_key[i] = tolower(m_key[i]);
+
+  unordered_map<string, unsigned int>::const_iterator p = m_index.find(m_key);
+  if(p != m_index.end())
+    return(p->second);
+
+  unsigned int ix = m_tracks.size();
+  m_index[m_key] = ix;
+  m_names.push_back(m_key);
+  m_tracks.push_back(OdomTrack());
+  m_tracks.back().setDepthThresh(m_depth_thresh);
+  m_tracks.back().setNoiseFloor(m_noise_floor);
+  m_times.push_back(-1);
+  return(ix);
+}
+
+//---------------------------------------------------------
+// Procedure: handleReport()
+//   Purpose: One pass over NAME=abe,X=12.1,Y=-40,SPD=1.5,...,TIME=..
+//            Values are converted in place with strtod, so nothing
+//            but the vehicle name is copied.
+
+bool FleetOdometry::handleReport(const string& report)
+{
+  m_reports++;
+
+  const char* name = 0;
+  unsigned int name_len = 0;
+  double x = 0, y = 0, depth = 0, time = -1;
+  bool got_x = false, got_y = false;
+
+  const char* str = report.c_str();
+  const char* end = str + report.size();
+  while(str < end) {
+    const char* eq = (const char*)memchr(str, '=', end - str);
+    if(!eq)
+      break;
+    const char* comma = (const char*)memchr(eq, ',', end - eq);
+    if(!comma)
+      comma = end;
+
+    unsigned int key_len = eq - str;
+    const char* val = eq + 1;
+    if((key_len == 4) && (strncasecmp(str, "NAME", 4) == 0)) {
+      name = val;
+      name_len = comma - val;
+    }
+    else if((key_len == 1) && ((*str == 'X') || (*str == 'x'))) {
+      x = strtod(val, 0);
+      got_x = true;
+    }
+    else if((key_len == 1) && ((*str == 'Y') || (*str == 'y'))) {
+      y = strtod(val, 0);
+      got_y = true;
+    }
+    else if((key_len == 3) && (strncasecmp(str, "DEP", 3) == 0))
+      depth = strtod(val, 0);
+    else if((key_len == 4) && (strncasecmp(str, "TIME", 4) == 0))
+      time = strtod(val, 0);
+
+    str = comma + 1;
+  }
+
+  if(!name || (name_len == 0) || !got_x || !got_y) {
+    m_rejected++;
+    return(false);
+  }
+
+  unsigned int ix = vehicleIndex(name, name_len);
+  if(time >= 0) {
+    if(time <= m_times[ix]) {
+      m_stale++;
+      return(true);
+    }
+    m_times[ix] = time;
+  }
+
+  m_tracks[ix].addFix(x, y, depth);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: getTotal()
+
+double FleetOdometry::getTotal() const
+{
+  double total = 0;
+  for(unsigned int i=0; i<m_tracks.size(); i++)
+    total += m_tracks[i].getDistance();
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: getSummary()
+
+string FleetOdometry::getSummary() const
+{
+  string summary = "vehicles=" + uintToString(m_tracks.size());
+  summary += ",total=" + doubleToStringX(getTotal(), 1);
+  for(unsigned int i=0; i<m_tracks.size(); i++) {
+    summary += "," + m_names[i] + "=";
+    summary += doubleToStringX(m_tracks[i].getDistance(), 1) + ":";
+    summary += doubleToStringX(m_tracks[i].getDistanceAtDepth(), 1);
+  }
+  return(summary);
+}
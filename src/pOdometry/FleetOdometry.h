@@ -0,0 +1,67 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: FleetOdometry.h                                 */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef FLEET_ODOMETRY_HEADER
+#define FLEET_ODOMETRY_HEADER
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "OdomTrack.h"
+
+// Odometry for a whole fleet, fed by NODE_REPORTs on the shoreside.
+// Vehicles are found through a hash map into a preallocated vector of
+// tracks, and each report is parsed in a single pass over the string
+// picking out only NAME, X, Y, DEP and TIME. Reports carrying a TIME no
+// later than the last one seen for that vehicle are ignored, so
+// duplicates relayed over several links do not add distance.
+
+class FleetOdometry
+{
+ public:
+  FleetOdometry();
+  ~FleetOdometry() {};
+
+  void reserve(unsigned int vehicles);
+  void setDepthThresh(double depth);
+  void setNoiseFloor(double floor);
+
+  // Returns false if the report has no NAME, X or Y
+  bool handleReport(const std::string& report);
+
+  // e.g. vehicles=2,total=1234.5,abe=512.3:0,ben=722.2:15.1
+  // with each vehicle as name=distance:distance_at_depth
+  std::string getSummary() const;
+
+  double getTotal() const;
+  unsigned int size() const              {return(m_tracks.size());};
+  unsigned int getReports() const        {return(m_reports);};
+  unsigned int getRejected() const       {return(m_rejected);};
+  unsigned int getStale() const          {return(m_stale);};
+
+  const std::string& getName(unsigned int ix) const  {return(m_names[ix]);};
+  const OdomTrack&   getTrack(unsigned int ix) const {return(m_tracks[ix]);};
+  double getLastTime(unsigned int ix) const          {return(m_times[ix]);};
+
+ protected:
+  unsigned int vehicleIndex(const char* name, unsigned int len);
+
+ private:
+  std::unordered_map<std::string, unsigned int> m_index;
+  std::vector<std::string> m_names;
+  std::vector<OdomTrack>   m_tracks;
+  std::vector<double>      m_times;   // TIME of the last report used
+
+  double       m_depth_thresh;
+  double       m_noise_floor;
+  std::string  m_key;                 // reused for map lookups
+  unsigned int m_reports;
+  unsigned int m_rejected;
+  unsigned int m_stale;
+};
+
+#endif
@@ -0,0 +1,238 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: LogReplay.cpp                                   */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "MBUtils.h"
+#include "LogReplay.h"
+
+using namespace std;
+
+enum {NAV_X=0, NAV_Y=1, NAV_DEPTH=2, NAV_OTHER=-1};
+
+//---------------------------------------------------------
+// Procedure: navVar()
+//   Purpose: Classify a variable name without copying it
+
+static int navVar(const char* str, unsigned int len)
+{
+  if((len < 5) || (memcmp(str, "NAV_", 4) != 0))
+    return(NAV_OTHER);
+  if(len == 5) {
+    if(str[4] == 'X')
+      return(NAV_X);
+    if(str[4] == 'Y')
+      return(NAV_Y);
+  }
+  else if((len == 9) && (memcmp(str + 4, "DEPTH", 5) == 0))
+    return(NAV_DEPTH);
+  return(NAV_OTHER);
+}
+
+//---------------------------------------------------------
+// Procedure: nextToken()
+//   Purpose: Find the next whitespace separated token in [str,end).
+//            Returns false if there is none.
+
+static bool nextToken(const char*& str, const char* end,
+                      const char*& tok, unsigned int& len)
+{
+  while((str < end) && ((*str == ' ') || (*str == '\t') || (*str == '\r')))
+    str++;
+  if(str >= end)
+    return(false);
+  tok = str;
+  while((str < end) && (*str != ' ') && (*str != '\t') && (*str != '\r'))
+    str++;
+  len = str - tok;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Constructor()
+
+LogReplay::LogReplay()
+{
+  m_slog = false;
+  m_slog_cols[0] = m_slog_cols[1] = m_slog_cols[2] = -1;
+  m_lines = 0;
+  m_nav_samples = 0;
+  m_bytes = 0;
+  m_start_time = -1;
+  m_end_time = -1;
+}
+
+//---------------------------------------------------------
+// Procedure: replay()
+
+bool LogReplay::replay(const string& filename)
+{
+  m_slog = strEnds(filename, ".slog");
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if(fd < 0) {
+    m_error = "Unable to open " + filename;
+    return(false);
+  }
+  struct stat info;
+  if((fstat(fd, &info) != 0) || (info.st_size == 0)) {
+    close(fd);
+    m_error = "Empty or unreadable file " + filename;
+    return(false);
+  }
+
+  size_t size = info.st_size;
+  void* data = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data == MAP_FAILED) {
+    m_error = "Unable to map " + filename;
+    return(false);
+  }
+  madvise(data, size, MADV_SEQUENTIAL);
+
+  const char* str = (const char*)data;
+  const char* end = str + size;
+  while(str < end) {
+    const char* eol = (const char*)memchr(str, '\n', end - str);
+    if(!eol)
+      eol = end;
+    m_lines++;
+
+    if(*str == '%') {
+      if(m_slog)
+        handleSLogHeader(str, eol);
+    }
+    else if(m_slog)
+      handleSLogLine(str, eol);
+    else
+      handleALogLine(str, eol);
+    str = eol + 1;
+  }
+
+  munmap(data, size);
+  m_bytes += size;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: handleALogLine()
+//   Purpose: <time> <var> <source> <value>. The value is only
+//            converted for the three variables we want.
+
+void LogReplay::handleALogLine(const char* line, const char* end)
+{
+  const char* tok;
+  unsigned int len;
+  if(!nextToken(line, end, tok, len))
+    return;
+  const char* time_str = tok;
+
+  if(!nextToken(line, end, tok, len))
+    return;
+  int var = navVar(tok, len);
+  if(var == NAV_OTHER)
+    return;
+
+  if(!nextToken(line, end, tok, len) || !nextToken(line, end, tok, len))
+    return;
+  handleNav(var, strtod(time_str, 0), strtod(tok, 0));
+}
+
+//---------------------------------------------------------
+// Procedure: handleSLogHeader()
+//   Purpose: Find the columns of the NAV variables from the
+//            "%% TIME  VAR1  VAR2 ..." line.
+
+void LogReplay::handleSLogHeader(const char* line, const char* end)
+{
+  const char* tok;
+  unsigned int len;
+  if(!nextToken(line, end, tok, len) || (len != 2) || (memcmp(tok, "%%", 2) != 0))
+    return;
+  if(!nextToken(line, end, tok, len) || (len != 4) || (memcmp(tok, "TIME", 4) != 0))
+    return;
+
+  // A second "%% TIME [..." line carries units, not names
+  if(!nextToken(line, end, tok, len) || (*tok == '['))
+    return;
+
+  m_slog_cols[0] = m_slog_cols[1] = m_slog_cols[2] = -1;
+  int col = 0;
+  do {
+    int var = navVar(tok, len);
+    if(var != NAV_OTHER)
+      m_slog_cols[var] = col;
+    col++;
+  } while(nextToken(line, end, tok, len));
+}
+
+//---------------------------------------------------------
+// Procedure: handleSLogLine()
+
+void LogReplay::handleSLogLine(const char* line, const char* end)
+{
+  if((m_slog_cols[NAV_X] < 0) && (m_slog_cols[NAV_Y] < 0))
+    return;
+
+  const char* tok;
+  unsigned int len;
+  if(!nextToken(line, end, tok, len))
+    return;
+  double time = strtod(tok, 0);
+
+  int col = 0;
+  while(nextToken(line, end, tok, len)) {
+    for(int var=0; var<3; var++) {
+      if(m_slog_cols[var] == col)
+        handleNav(var, time, strtod(tok, 0));
+    }
+    col++;
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: handleNav()
+//   Purpose: Feed one NAV value to the pairer. A .slog has NaN in a
+//            column with no value yet, and those are skipped.
+
+void LogReplay::handleNav(int var, double time, double val)
+{
+  if(!std::isfinite(time) || !std::isfinite(val))
+    return;
+
+  m_nav_samples++;
+  if(m_start_time < 0)
+    m_start_time = time;
+  m_end_time = time;
+
+  if(var == NAV_X)
+    m_nav.addX(time, val);
+  else if(var == NAV_Y)
+    m_nav.addY(time, val);
+  else
+    m_nav.addDepth(time, val);
+  drainFixes();
+}
+
+//---------------------------------------------------------
+// Procedure: drainFixes()
+
+void LogReplay::drainFixes()
+{
+  SampleRing<NavSample>& fixes = m_nav.fixes();
+  while(!fixes.empty()) {
+    const NavSample& fix = fixes.front();
+    double step = m_track.addFix(fix.x, fix.y, fix.depth);
+    m_stats.addSample(fix.t, step, fix.depth);
+    fixes.pop();
+  }
+}
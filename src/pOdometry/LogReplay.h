@@ -0,0 +1,69 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: LogReplay.h                                     */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef LOG_REPLAY_HEADER
+#define LOG_REPLAY_HEADER
+
+#include <string>
+#include "NavPairer.h"
+#include "OdomTrack.h"
+#include "WindowStats.h"
+
+// Offline odometry from a pLogger .alog or .slog file. The file is
+// memory mapped and read in a single pass; NAV_X, NAV_Y and NAV_DEPTH
+// go through the same NavPairer and OdomTrack as the live app, so the
+// numbers match what pOdometry would have posted during the mission.
+//
+//  .alog lines:  <time> <var> <source> <value>
+//  .slog lines:  <time> <value> <value> ... in the column order given
+//                by the "%% TIME ..." header line
+
+class LogReplay
+{
+ public:
+  LogReplay();
+  ~LogReplay() {};
+
+  void setDepthThresh(double depth)  {m_track.setDepthThresh(depth);};
+  void setNoiseFloor(double floor)   {m_track.setNoiseFloor(floor);};
+
+  // Returns false if the file could not be opened or mapped
+  bool replay(const std::string& filename);
+
+  const OdomTrack& getTrack() const  {return(m_track);};
+  WindowStats& getStats()            {return(m_stats);};
+  std::string getError() const       {return(m_error);};
+  unsigned long getLines() const     {return(m_lines);};
+  unsigned long getNavSamples() const  {return(m_nav_samples);};
+  unsigned long getBytes() const     {return(m_bytes);};
+  double getStartTime() const        {return(m_start_time);};
+  double getEndTime() const          {return(m_end_time);};
+
+ protected:
+  void handleALogLine(const char* line, const char* end);
+  void handleSLogLine(const char* line, const char* end);
+  void handleSLogHeader(const char* line, const char* end);
+  void handleNav(int var, double time, double val);
+  void drainFixes();
+
+ private:
+  NavPairer m_nav;
+  OdomTrack m_track;
+  WindowStats m_stats;
+
+  bool m_slog;
+  int  m_slog_cols[3];      // column of NAV_X, NAV_Y, NAV_DEPTH, or -1
+
+  std::string   m_error;
+  unsigned long m_lines;
+  unsigned long m_nav_samples;
+  unsigned long m_bytes;
+  double        m_start_time;
+  double        m_end_time;
+};
+
+#endif
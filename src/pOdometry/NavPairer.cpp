@@ -0,0 +1,189 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: NavPairer.cpp                                   */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#include <cmath>
+#include "NavPairer.h"
+
+using namespace std;
+
+// Samples on one axis closer than this are not interpolated between
+static const double TIME_EPSILON = 1e-6;
+
+//---------------------------------------------------------
+// Constructor()
+
+NavPairer::NavPairer(unsigned int capacity)
+{
+  m_have_prev_x = false;
+  m_have_prev_y = false;
+  m_last_x_time = -1;
+  m_last_y_time = -1;
+  m_last_depth_time = -1;
+  m_pair_tolerance = 0.05;
+  m_out_of_order = 0;
+  setCapacity(capacity);
+}
+
+//---------------------------------------------------------
+// Procedure: setCapacity()
+
+void NavPairer::setCapacity(unsigned int capacity)
+{
+  m_xs.setCapacity(capacity);
+  m_ys.setCapacity(capacity);
+  m_depths.setCapacity(capacity);
+  m_fixes.setCapacity(capacity);
+}
+
+//---------------------------------------------------------
+// Procedure: setPairTolerance()
+
+bool NavPairer::setPairTolerance(double secs)
+{
+  if(secs < 0)
+    return(false);
+  m_pair_tolerance = secs;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: addX()
+
+void NavPairer::addX(double t, double x)
+{
+  if(t < m_last_x_time) {
+    m_out_of_order++;
+    return;
+  }
+  m_last_x_time = t;
+
+  AxisSample sample = {t, x};
+  m_xs.push(sample);
+  pairSamples();
+}
+
+//---------------------------------------------------------
+// Procedure: addY()
+
+void NavPairer::addY(double t, double y)
+{
+  if(t < m_last_y_time) {
+    m_out_of_order++;
+    return;
+  }
+  m_last_y_time = t;
+
+  AxisSample sample = {t, y};
+  m_ys.push(sample);
+  pairSamples();
+}
+
+//---------------------------------------------------------
+// Procedure: addDepth()
+
+void NavPairer::addDepth(double t, double depth)
+{
+  if(t < m_last_depth_time) {
+    m_out_of_order++;
+    return;
+  }
+  m_last_depth_time = t;
+
+  AxisSample sample = {t, depth};
+  m_depths.push(sample);
+}
+
+//---------------------------------------------------------
+// Procedure: getDropped()
+//   Purpose: Samples lost to a full ring on any of the buffers
+
+unsigned int NavPairer::getDropped() const
+{
+  return(m_xs.dropped() + m_ys.dropped() + m_depths.dropped() +
+         m_fixes.dropped());
+}
+
+//---------------------------------------------------------
+// Procedure: pairSamples()
+//   Purpose: Merge the two axis streams in time order. The earlier
+//            head is turned into a fix using the other axis
+//            interpolated at its time; heads within the pairing
+//            tolerance pair directly.
+
+void NavPairer::pairSamples()
+{
+  while(!m_xs.empty() && !m_ys.empty()) {
+    AxisSample xs = m_xs.front();
+    AxisSample ys = m_ys.front();
+
+    if(fabs(xs.t - ys.t) <= m_pair_tolerance) {
+      emit((xs.t > ys.t) ? xs.t : ys.t, xs.v, ys.v);
+      m_prev_x = xs;
+      m_prev_y = ys;
+      m_have_prev_x = true;
+      m_have_prev_y = true;
+      m_xs.pop();
+      m_ys.pop();
+    }
+    else if(xs.t < ys.t) {
+      // Before the first Y there is nothing to interpolate from
+      if(m_have_prev_y)
+        emit(xs.t, xs.v, interpolate(m_prev_y, m_have_prev_y, ys, xs.t));
+      m_prev_x = xs;
+      m_have_prev_x = true;
+      m_xs.pop();
+    }
+    else {
+      if(m_have_prev_x)
+        emit(ys.t, interpolate(m_prev_x, m_have_prev_x, xs, ys.t), ys.v);
+      m_prev_y = ys;
+      m_have_prev_y = true;
+      m_ys.pop();
+    }
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: interpolate()
+
+double NavPairer::interpolate(const AxisSample& prev, bool have_prev,
+                              const AxisSample& next, double t) const
+{
+  if(!have_prev || (next.t - prev.t) <= TIME_EPSILON)
+    return(next.v);
+  double frac = (t - prev.t) / (next.t - prev.t);
+  return(prev.v + frac * (next.v - prev.v));
+}
+
+//---------------------------------------------------------
+// Procedure: depthAt()
+//   Purpose: Depth at time t. Fixes are emitted in time order, so
+//            depth samples older than the one at or before t are not
+//            needed again and are dropped here.
+
+double NavPairer::depthAt(double t)
+{
+  if(m_depths.empty())
+    return(0);
+
+  while((m_depths.size() > 1) && (m_depths.at(1).t <= t))
+    m_depths.pop();
+
+  const AxisSample& prev = m_depths.front();
+  if((m_depths.size() == 1) || (t <= prev.t))
+    return(prev.v);
+  return(interpolate(prev, true, m_depths.at(1), t));
+}
+
+//---------------------------------------------------------
+// Procedure: emit()
+
+void NavPairer::emit(double t, double x, double y)
+{
+  NavSample fix = {t, x, y, depthAt(t)};
+  m_fixes.push(fix);
+}
@@ -0,0 +1,133 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: NavPairer.h                                     */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef NAV_PAIRER_HEADER
+#define NAV_PAIRER_HEADER
+
+#include <vector>
+
+// Fixed-capacity FIFO. Storage is allocated once; pushing onto a full
+// ring drops the oldest element and counts it.
+template <class T>
+class SampleRing
+{
+ public:
+  SampleRing(unsigned int capacity=256) {setCapacity(capacity);};
+
+  void setCapacity(unsigned int capacity) {
+    m_buf.assign(capacity > 0 ? capacity : 1, T());
+    m_head = 0;
+    m_size = 0;
+    m_dropped = 0;
+  }
+
+  void push(const T& val) {
+    if(m_size == m_buf.size()) {
+      pop();
+      m_dropped++;
+    }
+    m_buf[(m_head + m_size) % m_buf.size()] = val;
+    m_size++;
+  }
+
+  void pop() {
+    if(m_size == 0)
+      return;
+    m_head = (m_head + 1) % m_buf.size();
+    m_size--;
+  }
+
+  const T& front() const  {return(m_buf[m_head]);};
+  const T& at(unsigned int ix) const  {return(m_buf[(m_head + ix) % m_buf.size()]);};
+  const T& back() const   {return(m_buf[(m_head + m_size - 1) % m_buf.size()]);};
+  bool  empty() const     {return(m_size == 0);};
+  unsigned int size() const      {return(m_size);};
+  unsigned int capacity() const  {return(m_buf.size());};
+  unsigned int dropped() const   {return(m_dropped);};
+
+ private:
+  std::vector<T> m_buf;
+  unsigned int   m_head;
+  unsigned int   m_size;
+  unsigned int   m_dropped;
+};
+
+// A position fix with the depth known at that time
+struct NavSample {
+  double t;
+  double x;
+  double y;
+  double depth;
+};
+
+// Pairs NAV_X and NAV_Y by their timestamps rather than their arrival
+// order. An X and a Y within the pairing tolerance of each other are
+// one fix, at the later of the two times; Notify stamps each post
+// separately, so a simulator's X and Y for the same step are usually
+// a few microseconds apart. Any other X or Y value becomes a fix at
+// its own timestamp, with the other coordinate interpolated between
+// the samples either side of it.
+// A fix is only produced once the other axis has a sample at or after
+// that time, so pairs that straddle mail batches are not lost and
+// fixes come out in time order. Depth is interpolated at the fix time
+// between the depth samples either side of it. A fix newer than the
+// latest depth sample takes that sample; depth never holds up a fix.
+
+class NavPairer
+{
+ public:
+  NavPairer(unsigned int capacity=256);
+  ~NavPairer() {};
+
+  void setCapacity(unsigned int capacity);
+
+  // Should be under half the nav period, so successive samples on one
+  // axis never pair with the same sample on the other
+  bool setPairTolerance(double secs);
+  double getPairTolerance() const  {return(m_pair_tolerance);};
+
+  // Samples older than the last one on the same axis are ignored
+  void addX(double t, double x);
+  void addY(double t, double y);
+  void addDepth(double t, double depth);
+
+  SampleRing<NavSample>& fixes()  {return(m_fixes);};
+
+  unsigned int getOutOfOrder() const  {return(m_out_of_order);};
+  unsigned int getDropped() const;
+
+ protected:
+  struct AxisSample {
+    double t;
+    double v;
+  };
+
+  void   pairSamples();
+  double interpolate(const AxisSample& prev, bool have_prev,
+                     const AxisSample& next, double t) const;
+  double depthAt(double t);
+  void   emit(double t, double x, double y);
+
+ private:
+  SampleRing<AxisSample> m_xs;
+  SampleRing<AxisSample> m_ys;
+  SampleRing<AxisSample> m_depths;
+  SampleRing<NavSample>  m_fixes;
+
+  AxisSample m_prev_x;    // last X consumed, used to interpolate
+  AxisSample m_prev_y;
+  bool       m_have_prev_x;
+  bool       m_have_prev_y;
+  double     m_last_x_time;
+  double     m_last_y_time;
+  double     m_last_depth_time;
+  double     m_pair_tolerance;
+
+  unsigned int m_out_of_order;
+};
+
+#endif
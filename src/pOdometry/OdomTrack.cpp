@@ -0,0 +1,64 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: OdomTrack.cpp                                   */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#include <cmath>
+#include "OdomTrack.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Constructor()
+
+OdomTrack::OdomTrack()
+{
+  m_depth_thresh = 999999999;
+  m_noise_floor  = 0;
+  reset();
+}
+
+//---------------------------------------------------------
+// Procedure: reset()
+
+void OdomTrack::reset()
+{
+  m_x = 0;
+  m_y = 0;
+  m_distance.reset();
+  m_distance_at_depth.reset();
+  m_fixes = 0;
+  m_filtered = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: addFix()
+//   Purpose: Written with selects rather than branches since it runs
+//            once per fix at the full nav rate. A fix that is not
+//            finite is ignored, or it would become the anchor every
+//            later step is measured from.
+
+double OdomTrack::addFix(double x, double y, double depth)
+{
+  if(!std::isfinite(x) || !std::isfinite(y))
+    return(0);
+
+  double delta_x = x - m_x;
+  double delta_y = y - m_y;
+  double step = sqrt(delta_x * delta_x + delta_y * delta_y);
+
+  bool first  = (m_fixes == 0);
+  bool accept = first || (step >= m_noise_floor);
+  step = (accept && !first) ? step : 0;
+
+  m_distance.add(step);
+  m_distance_at_depth.add((depth > m_depth_thresh) ? step : 0);
+
+  m_x = accept ? x : m_x;
+  m_y = accept ? y : m_y;
+  m_filtered += !accept;
+  m_fixes++;
+  return(step);
+}
@@ -0,0 +1,59 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: OdomTrack.h                                     */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef ODOM_TRACK_HEADER
+#define ODOM_TRACK_HEADER
+
+#include "CompensatedSum.h"
+
+// Distance travelled by one vehicle, integrated from a time ordered
+// series of position fixes. This is the integration shared by every
+// pOdometry mode; it knows nothing of MOOS.
+//
+// Steps shorter than the noise floor are treated as position jitter:
+// they are not counted and the track stays anchored at the last
+// accepted fix, so slow real motion still counts once it clears the
+// floor. Totals use compensated summation.
+
+class OdomTrack
+{
+ public:
+  OdomTrack();
+  ~OdomTrack() {};
+
+  void   setDepthThresh(double depth)  {m_depth_thresh = depth;};
+  double getDepthThresh() const        {return(m_depth_thresh);};
+  void   setNoiseFloor(double floor)   {m_noise_floor = floor;};
+  double getNoiseFloor() const         {return(m_noise_floor);};
+
+  // Returns the length of the step counted for this fix, which is
+  // zero for the first fix and for filtered jitter. A fix with a NaN
+  // or infinite coordinate is ignored and not counted as a fix.
+  double addFix(double x, double y, double depth);
+  void   reset();
+
+  bool   hasFix() const                {return(m_fixes > 0);};
+  double getX() const                  {return(m_x);};
+  double getY() const                  {return(m_y);};
+  double getDistance() const           {return(m_distance.get());};
+  double getDistanceAtDepth() const    {return(m_distance_at_depth.get());};
+  unsigned long getFixes() const       {return(m_fixes);};
+  unsigned long getFiltered() const    {return(m_filtered);};
+
+ private:
+  double m_depth_thresh;
+  double m_noise_floor;
+
+  double m_x;      // last accepted fix
+  double m_y;
+  CompensatedSum m_distance;
+  CompensatedSum m_distance_at_depth;
+  unsigned long  m_fixes;
+  unsigned long  m_filtered;
+};
+
+#endif
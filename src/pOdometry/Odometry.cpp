@@ -20,19 +20,22 @@ using namespace std;
 
 Odometry::Odometry()
 {
-  m_first_reading = true;
-  m_current_x  = 0.0;
-  m_current_y = 0.0;
-  m_previous_x = 0.0;
-  m_previous_y = 0.0;
-  m_total_distance = 0.0;
   m_timestamp = 0.0;
   m_nav_stale_thresh = 10.0;  // Default value if not specified in config
   m_depth_thresh = 999999999;
-  m_current_depth = 0.0;
-  m_odometry_at_depth = 0.0;
+  m_noise_floor = 0;
   m_unit_conversion = 1.0;  // Default to meters (no conversion)
   m_unit_name = "meters";   // Default unit name
+  m_debug_file = "pOdometry_debug.log";
+
+  m_stats_interval = 1;
+  m_stats_last_post = 0;
+  m_stats_last_samples = 0;
+
+  m_fleet_mode = false;
+  m_fleet_interval = 1;
+  m_fleet_last_post = 0;
+  m_fleet_last_reports = 0;
 }
 
 //---------------------------------------------------------
@@ -49,12 +52,6 @@ bool Odometry::OnNewMail(MOOSMSG_LIST &NewMail)
 {
   AppCastingMOOSApp::OnNewMail(NewMail);
 
-  // Initialize variables to track new position coordinates
-  double new_x = m_current_x;
-  double new_y = m_current_y;
-  bool got_next_x = false;
-  bool got_next_y = false;
-
   MOOSMSG_LIST::iterator p;
   for(p=NewMail.begin(); p!=NewMail.end(); p++) {
     CMOOSMsg &msg = *p;
@@ -67,43 +64,43 @@ bool Odometry::OnNewMail(MOOSMSG_LIST &NewMail)
       // Clear any existing NAV timeout warning
       retractRunWarning("NAV_TIMEOUT");
       
-      if(key == "NAV_X") { //NAV_X
-        new_x = dval;
-        if (got_next_y){
-          m_position_queue.push(std::make_pair(new_x, new_y));
-          got_next_x = false;
-          got_next_y = false;
-        } else {
-          got_next_x = true;
-        }
-        cout << "Got Nav X" << endl;
+      // Pair by the time each value was posted, not arrival order
+      if(key == "NAV_X") {
+        m_nav.addX(msg.GetTime(), dval);
+        m_debug.log(DBG_DEBUG, msg.GetTime(), "NAV_X", dval);
       }
-      else if(key == "NAV_Y") { // NAV_Y
-        new_y = dval;
-        if (got_next_x){
-          m_position_queue.push(std::make_pair(new_x, new_y));
-          got_next_y = false;
-          got_next_x = false;
-        } else {
-          got_next_y = true;
-        }
-        cout << "Got Nav Y" << endl;
+      else if(key == "NAV_Y") {
+        m_nav.addY(msg.GetTime(), dval);
+        m_debug.log(DBG_DEBUG, msg.GetTime(), "NAV_Y", dval);
       }
       else if(key == "NAV_DEPTH"){
-        m_current_depth = dval;
-        cout << "Got Nav Depth" << endl;
+        m_nav.addDepth(msg.GetTime(), dval);
+        m_debug.log(DBG_DEBUG, msg.GetTime(), "NAV_DEPTH", dval);
       }
+    }
+    else if(key == "NODE_REPORT") {
+      if(!m_fleet.handleReport(msg.GetString()))
+        m_debug.log(DBG_WARN, msg.GetTime(), "bad NODE_REPORT");
+    }
     else if(key == "ODOMETRY_UNITS") {
       string value = msg.GetString();
-      handleUnitChange(value);
+      if(!handleUnitChange(value))
+        m_debug.log(DBG_WARN, msg.GetTime(), "bad ODOMETRY_UNITS");
+    }
+    else if(key == "ODOMETRY_DEBUG_DUMP") {
+      string value = msg.GetString();
+      if(value == "")
+        value = m_debug_file;
+      if(m_debug.dumpToFile(value))
+        retractRunWarning("Unable to write debug log");
+      else
+        reportRunWarning("Unable to write debug log: " + value);
     }
     else if(key != "APPCAST_REQ")
       reportRunWarning("Unhandled Mail: " + key);
-   }
-   
-   
-}
-    return(true);
+  }
+
+  return(true);
 }
 
 //---------------------------------------------------------
@@ -123,60 +120,88 @@ bool Odometry::Iterate()
 {
   AppCastingMOOSApp::Iterate();
 
-  // Check for NAV timeout using configurable threshold
   double current_time = MOOSTime();
+  if(m_fleet_mode) {
+    postFleetSummary(current_time);
+    AppCastingMOOSApp::PostReport();
+    return(true);
+  }
+
+  // Check for NAV timeout using configurable threshold
   if (current_time - m_timestamp > m_nav_stale_thresh) {
     reportRunWarning("NAV_TIMEOUT: No NAV_X or NAV_Y updates received in over " + 
                     doubleToString(m_nav_stale_thresh) + " seconds");
+    m_debug.log(DBG_WARN, current_time, "NAV timeout", current_time - m_timestamp);
   }
 
-  // Process all positions in queue
-  while(!m_position_queue.empty()) {
-    std::pair<double, double> new_pos = m_position_queue.front();
-    m_position_queue.pop();
-    
-    // Skip distance calculation on first reading
-    if(m_first_reading) {
-      m_first_reading = false;
-      m_current_x = new_pos.first;
-      m_current_y = new_pos.second;
-    }
-    else {
-      // Store current position as previous
-      m_previous_x = m_current_x;
-      m_previous_y = m_current_y;
-      
-      // Update current position
-      m_current_x = new_pos.first;
-      m_current_y = new_pos.second;
-
-      // Calculate distance using Pythagorean theorem
-      double delta_x = m_current_x - m_previous_x;
-      double delta_y = m_current_y - m_previous_y;
-      double step_distance = sqrt(delta_x * delta_x + delta_y * delta_y);
-      
-      // Add to total distance
-      m_total_distance += step_distance;
+  // Process all paired positions, in time order
+  SampleRing<NavSample>& fixes = m_nav.fixes();
+  while(!fixes.empty()) {
+    NavSample fix = fixes.front();
+    fixes.pop();
+    double step = m_track.addFix(fix.x, fix.y, fix.depth);
+    m_stats.addSample(fix.t, step, fix.depth);
+  }
 
-      // Process odometry only if depth > 25 meters
-      if(m_current_depth > m_depth_thresh) {
-        m_odometry_at_depth += step_distance;
-       }
+  // Post only when the publish policy says the value is worth it.
+  // The converted value goes out alongside the meters value.
+  double total_distance = m_track.getDistance();
+  double odometry_at_depth = m_track.getDistanceAtDepth();
+  if(m_dist_gate.check(total_distance, current_time)) {
+    Notify("ODOMETRY_DIST", total_distance);  // Always publish in meters
+    if(m_unit_conversion != 1.0) {
+      double converted_dist = total_distance * m_unit_conversion;
+      Notify("ODOMETRY_DIST_" + toupper(m_unit_name), converted_dist);
     }
   }
+  if(m_depth_gate.check(odometry_at_depth, current_time))
+    Notify("ODOMETRY_DIST_AT_DEPTH", odometry_at_depth);
 
-  // When publishing the odometry distance, publish both the original and converted values
-  if(m_unit_conversion != 1.0) {
-    double converted_dist = m_total_distance * m_unit_conversion;
-    Notify("ODOMETRY_DIST_" + toupper(m_unit_name), converted_dist);
-  }
-  Notify("ODOMETRY_DIST", m_total_distance);  // Always publish in meters
-  Notify("ODOMETRY_DIST_AT_DEPTH", m_odometry_at_depth);
+  if(m_stats.active())
+    postWindowStats(current_time);
   
   AppCastingMOOSApp::PostReport();
   return(true);
 }
 
+//---------------------------------------------------------
+// Procedure: postWindowStats()
+//   Purpose: Post the window and depth band statistics at most every
+//            stats_interval seconds, and only if there are new fixes.
+
+void Odometry::postWindowStats(double current_time)
+{
+  if((current_time - m_stats_last_post) < m_stats_interval)
+    return;
+  if(m_stats.getSamples() == m_stats_last_samples)
+    return;
+
+  if(m_stats.sizeWindows() > 0)
+    Notify("ODOMETRY_WINDOW", m_stats.getWindowSummary());
+  if(m_stats.sizeBands() > 0)
+    Notify("ODOMETRY_DEPTH_BANDS", m_stats.getBandSummary());
+  m_stats_last_post = current_time;
+  m_stats_last_samples = m_stats.getSamples();
+}
+
+//---------------------------------------------------------
+// Procedure: postFleetSummary()
+//   Purpose: Post the fleet summary at most every fleet_interval
+//            seconds, and only if reports have come in since.
+
+void Odometry::postFleetSummary(double current_time)
+{
+  if((current_time - m_fleet_last_post) < m_fleet_interval)
+    return;
+  if(m_fleet.getReports() == m_fleet_last_reports)
+    return;
+
+  Notify("ODOMETRY_FLEET", m_fleet.getSummary());
+  Notify("ODOMETRY_FLEET_TOTAL", m_fleet.getTotal());
+  m_fleet_last_post = current_time;
+  m_fleet_last_reports = m_fleet.getReports();
+}
+
 //---------------------------------------------------------
 // Procedure: OnStartUp()
 //            happens before connection is open
@@ -219,17 +244,82 @@ bool Odometry::OnStartUp()
       handled = handleUnitChange(value);
     }
     else if(param == "depth_thresh") {
-      handled = setDoubleOnString(m_depth_thresh, value);  // Placeholder for future parameter
+      handled = setDoubleOnString(m_depth_thresh, value);
+    }
+    else if(param == "noise_floor") {
+      handled = setNonNegDoubleOnString(m_noise_floor, value);
+    }
+    else if(param == "stats_windows") {
+      handled = m_stats.setWindows(value);
+    }
+    else if(param == "depth_bands") {
+      handled = m_stats.setDepthBands(value);
+    }
+    else if(param == "stats_interval") {
+      handled = setNonNegDoubleOnString(m_stats_interval, value);
+    }
+    else if(param == "fleet_mode") {
+      handled = setBooleanOnString(m_fleet_mode, value);
+    }
+    else if(param == "fleet_interval") {
+      handled = setNonNegDoubleOnString(m_fleet_interval, value);
+    }
+    else if(param == "fleet_capacity") {
+      unsigned int capacity = 0;
+      handled = setUIntOnString(capacity, value) && (capacity > 0);
+      if(handled)
+        m_fleet.reserve(capacity);
     }
     else if(param == "bar") {
       handled = true;  // Placeholder for future parameter
     }
+    else if(param == "publish_policy") {
+      handled = m_dist_gate.setPolicy(value) && m_depth_gate.setPolicy(value);
+    }
+    else if(param == "publish_min_delta") {
+      double delta = atof(value.c_str());
+      handled = isNumber(value) && m_dist_gate.setMinDelta(delta) &&
+        m_depth_gate.setMinDelta(delta);
+    }
+    else if(param == "publish_max_interval") {
+      double secs = atof(value.c_str());
+      handled = isNumber(value) && m_dist_gate.setMaxInterval(secs) &&
+        m_depth_gate.setMaxInterval(secs);
+    }
+    else if(param == "nav_buffer") {
+      unsigned int capacity = 0;
+      handled = setUIntOnString(capacity, value) && (capacity > 0);
+      if(handled)
+        m_nav.setCapacity(capacity);
+    }
+    else if(param == "nav_pair_tolerance") {
+      double secs = atof(value.c_str());
+      handled = isNumber(value) && m_nav.setPairTolerance(secs);
+    }
+    else if(param == "debug_level") {
+      handled = m_debug.setLevel(value);
+    }
+    else if(param == "debug_file") {
+      if(value != "") {
+        m_debug_file = value;
+        handled = true;
+      }
+    }
 
     // Report any unhandled parameters
     if(!handled)
       reportUnhandledConfigWarning(orig);
   }
   
+  m_track.setDepthThresh(m_depth_thresh);
+  m_track.setNoiseFloor(m_noise_floor);
+  m_fleet.setDepthThresh(m_depth_thresh);
+  m_fleet.setNoiseFloor(m_noise_floor);
+
+  // Dump the debug log if we go down hard
+  m_debug.installCrashDump(m_debug_file);
+  m_debug.log(DBG_INFO, MOOSTime(), "started, debug level", m_debug.getLevel());
+
   // Register for variables we want to receive
   registerVariables();	
   return(true);
@@ -241,10 +331,15 @@ bool Odometry::OnStartUp()
 void Odometry::registerVariables()
 {
   AppCastingMOOSApp::RegisterVariables();
-  Register("NAV_X", 0);
-  Register("NAV_Y", 0);
-  Register("NAV_DEPTH", 0);
+  if(m_fleet_mode)
+    Register("NODE_REPORT", 0);
+  else {
+    Register("NAV_X", 0);
+    Register("NAV_Y", 0);
+    Register("NAV_DEPTH", 0);
+  }
   Register("ODOMETRY_UNITS", 0);
+  Register("ODOMETRY_DEBUG_DUMP", 0);
 }
 
 
@@ -256,19 +351,61 @@ bool Odometry::buildReport()
   m_msgs << "============================================" << endl;
   m_msgs << "File:                                       " << endl;
   m_msgs << "============================================" << endl;
-  m_msgs << "Current Odometry:  " << m_total_distance << endl;
-  m_msgs << "NAV X:  " << m_current_x << endl;
-  m_msgs << "NAV Y:  " << m_current_y << endl;
-  m_msgs << "ODOMETRY_DIST_AT_DEPTH: " << m_odometry_at_depth << endl;
+  if(m_fleet_mode) {
+    buildFleetReport();
+    return(true);
+  }
+
+  m_msgs << "Current Odometry:  " << m_track.getDistance() << endl;
+  m_msgs << "NAV X:  " << m_track.getX() << endl;
+  m_msgs << "NAV Y:  " << m_track.getY() << endl;
+  m_msgs << "ODOMETRY_DIST_AT_DEPTH: " << m_track.getDistanceAtDepth() << endl;
+  if(m_noise_floor > 0)
+    m_msgs << "Jitter steps dropped: " << m_track.getFiltered() << " of "
+           << m_track.getFixes() << " (noise floor " << doubleToStringX(m_noise_floor) << " m)" << endl;
+  for(unsigned int i=0; i<m_stats.sizeWindows(); i++) {
+    m_msgs << "Last " << doubleToStringX(m_stats.getWindow(i)) << "s: ";
+    m_msgs << doubleToStringX(m_stats.getDistance(i), 1) << " m, ";
+    m_msgs << doubleToStringX(m_stats.getSpeed(i), 2) << " m/s (peak ";
+    m_msgs << doubleToStringX(m_stats.getPeakSpeed(i), 2) << ")" << endl;
+  }
+  if(m_stats.sizeBands() > 0)
+    m_msgs << "Depth bands: " << m_stats.getBandSummary() << endl;
+  m_msgs << "Publish policy: " << m_dist_gate.getPolicy();
+  if(m_dist_gate.getPolicy() == "delta")
+    m_msgs << " (" << doubleToStringX(m_dist_gate.getMinDelta()) << " m)";
+  m_msgs << ", max interval " << doubleToStringX(m_dist_gate.getMaxInterval()) << "s" << endl;
+  m_msgs << "ODOMETRY_DIST posts:          " << m_dist_gate.getPostCount() << endl;
+  m_msgs << "ODOMETRY_DIST_AT_DEPTH posts: " << m_depth_gate.getPostCount() << endl;
+  m_msgs << "NAV samples dropped (buffer full):  " << m_nav.getDropped() << endl;
+  m_msgs << "NAV samples dropped (out of order): " << m_nav.getOutOfOrder() << endl;
+  m_msgs << "Debug log entries: " << m_debug.getCount() << endl;
+
+  return(true);
+}
+
+//------------------------------------------------------------
+// Procedure: buildFleetReport()
 
+void Odometry::buildFleetReport()
+{
+  m_msgs << "Fleet mode: " << m_fleet.size() << " vehicles, " << m_fleet.getReports()
+         << " reports (" << m_fleet.getStale() << " stale, " << m_fleet.getRejected()
+         << " rejected)" << endl;
+  m_msgs << "Fleet odometry: " << doubleToStringX(m_fleet.getTotal(), 1) << " m" << endl;
+  m_msgs << endl;
 
   ACTable actab(4);
-  actab << "Alpha | Bravo | Charlie | Delta";
+  actab << "Vehicle | Distance | At Depth | Last Report";
   actab.addHeaderLines();
-  actab << "one" << "two" << "three" << "four";
+  for(unsigned int i=0; i<m_fleet.size(); i++) {
+    const OdomTrack& track = m_fleet.getTrack(i);
+    actab << m_fleet.getName(i);
+    actab << doubleToStringX(track.getDistance(), 1);
+    actab << doubleToStringX(track.getDistanceAtDepth(), 1);
+    actab << doubleToStringX(m_fleet.getLastTime(i), 1);
+  }
   m_msgs << actab.getFormattedString();
-
-  return(true);
 }
 
 bool Odometry::handleUnitChange(string unit_spec)
@@ -300,6 +437,9 @@ bool Odometry::handleUnitChange(string unit_spec)
     reportRunWarning("Unrecognized unit specification: " + unit_spec);
     return false;
   }
+
+  // Make sure the new unit variable goes out on the next iteration
+  m_dist_gate.reset();
   
   return true;
 }
@@ -9,7 +9,12 @@
 #define Odometry_HEADER
 
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
-#include <queue>
+#include "DebugRing.h"
+#include "NavPairer.h"
+#include "PublishGate.h"
+#include "OdomTrack.h"
+#include "FleetOdometry.h"
+#include "WindowStats.h"
 
 class Odometry : public AppCastingMOOSApp
 {
@@ -29,22 +34,34 @@ class Odometry : public AppCastingMOOSApp
  protected:
    void registerVariables();
    bool handleUnitChange(std::string unit_spec);
+  void postWindowStats(double current_time);
+  void postFleetSummary(double current_time);
+  void buildFleetReport();
 
  private: // Configuration variables
-  bool m_first_reading;
-  double m_current_x;
-  double m_current_y;
-  double m_previous_x;
-  double m_previous_y;
-  double m_total_distance;
   double m_timestamp;
-  std::queue<std::pair<double, double>> m_position_queue;
+  NavPairer m_nav;               // NAV_X/NAV_Y paired by timestamp
   double m_nav_stale_thresh;
   double m_unit_conversion;  // Multiplier for converting meters to desired units
   std::string m_unit_name;       // Name of the current unit (e.g., "meters", "feet", etc.)
   double m_depth_thresh;
-  double m_current_depth;
-  double m_odometry_at_depth;
+  double m_noise_floor;          // Steps shorter than this are jitter
+  OdomTrack m_track;             // Distance integrated from NAV fixes
+  std::string m_debug_file;      // Where the debug log is dumped
+  DebugRing m_debug;
+  PublishGate m_dist_gate;       // ODOMETRY_DIST and ODOMETRY_DIST_<UNIT>
+  PublishGate m_depth_gate;      // ODOMETRY_DIST_AT_DEPTH
+
+  WindowStats m_stats;           // Rolling windows and depth bands
+  double m_stats_interval;       // Seconds between stats posts
+  double m_stats_last_post;
+  unsigned long m_stats_last_samples;
+
+  bool   m_fleet_mode;           // Shoreside: odometry from NODE_REPORTs
+  double m_fleet_interval;       // Seconds between fleet summaries
+  double m_fleet_last_post;
+  unsigned int  m_fleet_last_reports;
+  FleetOdometry m_fleet;
   private: // State variables
 };
 
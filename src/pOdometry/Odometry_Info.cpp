@@ -35,6 +35,7 @@ void showHelpAndExit()
   blk("                                                                ");
   blu("=============================================================== ");
   blu("Usage: pOdometry file.moos [OPTIONS]                   ");
+  blu("       pOdometry --replay file.alog [file.slog ...]           ");
   blu("=============================================================== ");
   blk("                                                                ");
   showSynopsis();
@@ -49,6 +50,19 @@ void showHelpAndExit()
   blk("      Display this help message.                                ");
   mag("  --interface, -i                                               ");
   blk("      Display MOOS publications and subscriptions.              ");
+  mag("  --replay, -r                                                  ");
+  blk("      Compute odometry offline from the given .alog/.slog       ");
+  blk("      files, from their NAV_X, NAV_Y and NAV_DEPTH entries,     ");
+  blk("      and exit. Uses the same pairing and integration as the    ");
+  blk("      live app.                                                 ");
+  mag("  --depth_thresh","=<meters>                                    ");
+  blk("      With --replay, also report distance below this depth.     ");
+  mag("  --noise_floor","=<meters>                                     ");
+  blk("      With --replay, drop steps shorter than this as jitter.    ");
+  mag("  --windows","=<secs,secs>                                      ");
+  blk("      With --replay, report the peak speed over these windows.  ");
+  mag("  --depth_bands","=<m,m,..>                                     ");
+  blk("      With --replay, report distance in each depth band.        ");
   mag("  --version,-v                                                  ");
   blk("      Display the release version of pOdometry.        ");
   blk("                                                                ");
@@ -74,6 +88,45 @@ void showExampleConfigAndExit()
   blk("  AppTick   = 4                                                 ");
   blk("  CommsTick = 4                                                 ");
   blk("                                                                ");
+  blk("  nav_stale_thresh = 10          // seconds                     ");
+  blk("  distance_units   = meters      // or feet,yards,km,miles      ");
+  blk("  depth_thresh     = 25          // meters                      ");
+  blk("  noise_floor      = 0.2         // meters, steps shorter are   ");
+  blk("                                 // jitter. Default 0 (off)     ");
+  blk("                                                                ");
+  blk("  // When to post ODOMETRY_DIST* again: always, on_change, or    ");
+  blk("  // delta (moved at least publish_min_delta meters). Values are ");
+  blk("  // always re-posted after publish_max_interval secs (0=never). ");
+  blk("  publish_policy       = on_change   // default                 ");
+  blk("  publish_min_delta    = 1           // meters, default         ");
+  blk("  publish_max_interval = 5           // seconds, default        ");
+  blk("                                                                ");
+  blk("  // NAV_X and NAV_Y are paired by timestamp, interpolating     ");
+  blk("  // when they arrive at different times. Fixes awaiting a      ");
+  blk("  // later sample on the other axis are held in a ring of       ");
+  blk("  // this size.                                                 ");
+  blk("  nav_buffer       = 256                                        ");
+  blk("                                                                ");
+  blk("  // An X and a Y stamped within this many secs of each other   ");
+  blk("  // are one fix. Keep it under half the NAV period.            ");
+  blk("  nav_pair_tolerance = 0.05     // seconds, default             ");
+  blk("                                                                ");
+  blk("  // Rolling distance and speed over ground over the last N     ");
+  blk("  // seconds, and distance binned by depth band (edges in m).   ");
+  blk("  stats_windows    = 10,60       // seconds, default none       ");
+  blk("  depth_bands      = 5,10,25     // 0-5,5-10,10-25,25+          ");
+  blk("  stats_interval   = 1           // secs between posts          ");
+  blk("                                                                ");
+  blk("  // Shoreside fleet mode: odometry for every vehicle from      ");
+  blk("  // NODE_REPORT instead of this vehicle's NAV_* variables.     ");
+  blk("  fleet_mode       = false       // default                     ");
+  blk("  fleet_interval   = 1           // secs between summaries      ");
+  blk("  fleet_capacity   = 128         // vehicles to preallocate     ");
+  blk("                                                                ");
+  blk("  // In-memory debug log, written out on ODOMETRY_DEBUG_DUMP     ");
+  blk("  // or when the app crashes. Never written to stdout.          ");
+  blk("  debug_level      = info        // error,warn,info,debug       ");
+  blk("  debug_file       = pOdometry_debug.log                        ");
   blk("}                                                               ");
   blk("                                                                ");
   exit(0);
@@ -94,12 +147,28 @@ void showInterfaceAndExit()
   blk("                                                                ");
   blk("SUBSCRIPTIONS:                                                  ");
   blk("------------------------------------                            ");
-  blk("  NODE_MESSAGE = src_node=alpha,dest_node=bravo,var_name=FOO,   ");
-  blk("                 string_val=BAR                                 ");
+  blk("  NAV_X, NAV_Y, NAV_DEPTH = Vehicle position and depth.         ");
+  blk("  ODOMETRY_UNITS          = Units for ODOMETRY_DIST_<UNIT>,      ");
+  blk("                            e.g. feet.                          ");
+  blk("  NODE_REPORT             = Vehicle reports, fleet mode only.   ");
+  blk("  ODOMETRY_DEBUG_DUMP     = Write the debug log to the named    ");
+  blk("                            file, or to debug_file if empty.    ");
   blk("                                                                ");
   blk("PUBLICATIONS:                                                   ");
   blk("------------------------------------                            ");
-  blk("  Publications are determined by the node message content.      ");
+  blk("  ODOMETRY_DIST           = Distance travelled, in meters.      ");
+  blk("  ODOMETRY_DIST_<UNIT>    = Distance in the configured units.   ");
+  blk("  ODOMETRY_DIST_AT_DEPTH  = Distance travelled below            ");
+  blk("                            depth_thresh, in meters.            ");
+  blk("  ODOMETRY_WINDOW         = dist_10=12.1,sog_10=1.21,...        ");
+  blk("                            for each of stats_windows.          ");
+  blk("  ODOMETRY_DEPTH_BANDS    = 0-5=1220.4,5-10=310.2,10-25=0,25+=0 ");
+  blk("                                                                ");
+  blk("  In fleet mode these replace the above:                        ");
+  blk("  ODOMETRY_FLEET          = vehicles=2,total=1234.5,             ");
+  blk("                            abe=512.3:0,ben=722.2:15.1          ");
+  blk("                            (name=distance:distance_at_depth)   ");
+  blk("  ODOMETRY_FLEET_TOTAL    = Fleet distance, in meters.          ");
   blk("                                                                ");
   exit(0);
 }
@@ -0,0 +1,104 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: PublishGate.cpp                                 */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#include <cmath>
+#include "MBUtils.h"
+#include "PublishGate.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Constructor()
+
+PublishGate::PublishGate()
+{
+  m_policy       = ON_CHANGE;
+  m_min_delta    = 1;
+  m_max_interval = 5;
+
+  m_posted     = false;
+  m_last_val   = 0;
+  m_last_time  = 0;
+  m_post_count = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: setPolicy()
+
+bool PublishGate::setPolicy(string policy)
+{
+  policy = tolower(policy);
+  if(policy == "always")
+    m_policy = ALWAYS;
+  else if(policy == "on_change")
+    m_policy = ON_CHANGE;
+  else if(policy == "delta")
+    m_policy = DELTA;
+  else
+    return(false);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: getPolicy()
+
+string PublishGate::getPolicy() const
+{
+  if(m_policy == ALWAYS)
+    return("always");
+  if(m_policy == ON_CHANGE)
+    return("on_change");
+  return("delta");
+}
+
+//---------------------------------------------------------
+// Procedure: setMinDelta()
+
+bool PublishGate::setMinDelta(double delta)
+{
+  if(delta <= 0)
+    return(false);
+  m_min_delta = delta;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: setMaxInterval()
+
+bool PublishGate::setMaxInterval(double secs)
+{
+  if(secs < 0)
+    return(false);
+  m_max_interval = secs;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: check()
+
+bool PublishGate::check(double val, double time)
+{
+  bool post = !m_posted;
+  if(!post && (m_max_interval > 0) && ((time - m_last_time) >= m_max_interval))
+    post = true;
+  if(!post) {
+    if(m_policy == ALWAYS)
+      post = true;
+    else if(m_policy == ON_CHANGE)
+      post = (val != m_last_val);
+    else
+      post = (fabs(val - m_last_val) >= m_min_delta);
+  }
+
+  if(post) {
+    m_posted    = true;
+    m_last_val  = val;
+    m_last_time = time;
+    m_post_count++;
+  }
+  return(post);
+}
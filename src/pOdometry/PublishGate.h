@@ -0,0 +1,53 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: PublishGate.h                                   */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef PUBLISH_GATE_HEADER
+#define PUBLISH_GATE_HEADER
+
+#include <string>
+
+// Decides whether a value is worth posting again. Policies:
+//   always    - every time it is asked
+//   on_change - when the value differs from the last one posted
+//   delta     - when it has moved at least min_delta since then
+// Whatever the policy, the value is posted the first time, and again
+// once max_interval seconds have passed (0 disables this).
+
+class PublishGate
+{
+ public:
+  PublishGate();
+  ~PublishGate() {};
+
+  bool setPolicy(std::string policy);
+  bool setMinDelta(double delta);
+  bool setMaxInterval(double secs);
+
+  std::string getPolicy() const;
+  double getMinDelta() const     {return(m_min_delta);};
+  double getMaxInterval() const  {return(m_max_interval);};
+
+  // Returns true, and records the value as posted, if it should go out
+  bool check(double val, double time);
+  void reset()  {m_posted = false;};
+
+  unsigned int getPostCount() const  {return(m_post_count);};
+
+ private:
+  enum Policy {ALWAYS, ON_CHANGE, DELTA};
+
+  Policy m_policy;
+  double m_min_delta;
+  double m_max_interval;
+
+  bool   m_posted;
+  double m_last_val;
+  double m_last_time;
+  unsigned int m_post_count;
+};
+
+#endif
@@ -0,0 +1,201 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: WindowStats.cpp                                 */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include "MBUtils.h"
+#include "WindowStats.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Procedure: parseNumbers()
+//   Purpose: Comma separated positive numbers, sorted ascending
+
+static bool parseNumbers(string spec, vector<double>& vals)
+{
+  vals.clear();
+  vector<string> svector = parseString(spec, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string sval = stripBlankEnds(svector[i]);
+    if(!isNumber(sval))
+      return(false);
+    double val = atof(sval.c_str());
+    if(val <= 0)
+      return(false);
+    vals.push_back(val);
+  }
+  sort(vals.begin(), vals.end());
+  vals.erase(unique(vals.begin(), vals.end()), vals.end());
+  return(vals.size() > 0);
+}
+
+//---------------------------------------------------------
+// Constructor()
+
+WindowStats::WindowStats()
+{
+  m_ring.resize(256);
+  m_mask   = m_ring.size() - 1;
+  m_oldest = 0;
+  m_next   = 0;
+  m_cum    = 0;
+  m_first_time = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: setWindows()
+
+bool WindowStats::setWindows(string spec)
+{
+  vector<double> windows;
+  if(!parseNumbers(spec, windows))
+    return(false);
+
+  m_windows = windows;
+  m_start.assign(windows.size(), m_oldest);
+  m_peak_speed.assign(windows.size(), 0);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: setDepthBands()
+
+bool WindowStats::setDepthBands(string spec)
+{
+  vector<double> edges;
+  if(!parseNumbers(spec, edges))
+    return(false);
+
+  m_band_edges = edges;
+  m_band_dist.assign(edges.size() + 1, CompensatedSum());
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: grow()
+//   Purpose: Double the ring, keeping samples at their absolute
+//            index modulo the new size.
+
+void WindowStats::grow()
+{
+  vector<Sample> ring(m_ring.size() * 2);
+  unsigned long mask = ring.size() - 1;
+  for(unsigned long ix=m_oldest; ix<m_next; ix++)
+    ring[ix & mask] = sample(ix);
+  m_ring.swap(ring);
+  m_mask = mask;
+}
+
+//---------------------------------------------------------
+// Procedure: addSample()
+
+void WindowStats::addSample(double t, double step, double depth)
+{
+  if(m_band_dist.size() > 0) {
+    unsigned int band = upper_bound(m_band_edges.begin(), m_band_edges.end(), depth) -
+      m_band_edges.begin();
+    m_band_dist[band].add(step);
+  }
+
+  if(m_windows.size() == 0)
+    return;
+
+  if((m_next - m_oldest) == m_ring.size())
+    grow();
+  if(m_next == 0)
+    m_first_time = t;
+  m_cum += step;
+  Sample& newest = sample(m_next);
+  newest.t   = t;
+  newest.cum = m_cum;
+  m_next++;
+
+  // Advance each window past samples that have aged out of it
+  for(unsigned int i=0; i<m_windows.size(); i++) {
+    double cutoff = t - m_windows[i];
+    while(sample(m_start[i]).t < cutoff)
+      m_start[i]++;
+
+    // Only count a peak once the window has filled
+    if((t - m_first_time) >= m_windows[i]) {
+      double speed = getSpeed(i);
+      if(speed > m_peak_speed[i])
+        m_peak_speed[i] = speed;
+    }
+  }
+
+  // The longest window holds the oldest sample anyone still needs
+  m_oldest = m_start.back();
+}
+
+//---------------------------------------------------------
+// Procedure: getDistance()
+//   Purpose: Distance travelled between the oldest and newest
+//            samples inside window i.
+
+double WindowStats::getDistance(unsigned int i) const
+{
+  if(m_next == 0)
+    return(0);
+  return(sample(m_next - 1).cum - sample(m_start[i]).cum);
+}
+
+//---------------------------------------------------------
+// Procedure: getSpeed()
+//   Purpose: Average speed over ground across window i.
+
+double WindowStats::getSpeed(unsigned int i) const
+{
+  if(m_next == 0)
+    return(0);
+  double span = sample(m_next - 1).t - sample(m_start[i]).t;
+  if(span <= 0)
+    return(0);
+  return(getDistance(i) / span);
+}
+
+//---------------------------------------------------------
+// Procedure: getBandName()
+
+string WindowStats::getBandName(unsigned int i) const
+{
+  if(i == m_band_edges.size())
+    return(doubleToStringX(m_band_edges.back()) + "+");
+  string lower = (i == 0) ? "0" : doubleToStringX(m_band_edges[i-1]);
+  return(lower + "-" + doubleToStringX(m_band_edges[i]));
+}
+
+//---------------------------------------------------------
+// Procedure: getWindowSummary()
+
+string WindowStats::getWindowSummary() const
+{
+  string summary;
+  for(unsigned int i=0; i<m_windows.size(); i++) {
+    string wstr = doubleToStringX(m_windows[i]);
+    if(i > 0)
+      summary += ",";
+    summary += "dist_" + wstr + "=" + doubleToStringX(getDistance(i), 1);
+    summary += ",sog_" + wstr + "=" + doubleToStringX(getSpeed(i), 2);
+  }
+  return(summary);
+}
+
+//---------------------------------------------------------
+// Procedure: getBandSummary()
+
+string WindowStats::getBandSummary() const
+{
+  string summary;
+  for(unsigned int i=0; i<m_band_dist.size(); i++) {
+    if(i > 0)
+      summary += ",";
+    summary += getBandName(i) + "=" + doubleToStringX(m_band_dist[i].get(), 1);
+  }
+  return(summary);
+}
@@ -0,0 +1,82 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: WindowStats.h                                   */
+/*    DATE: December 29th, 1963                             */
+/************************************************************/
+
+#ifndef WINDOW_STATS_HEADER
+#define WINDOW_STATS_HEADER
+
+#include <string>
+#include <vector>
+#include "CompensatedSum.h"
+
+// Rolling kinematics over one or more time windows, and distance
+// binned by depth band. Samples are kept in a ring in time order along
+// with the running distance, so the distance over a window is the
+// difference of two prefix sums. Each window keeps the index of its
+// oldest sample, which only ever moves forward, so each sample costs
+// O(1) amortized per window.
+
+class WindowStats
+{
+ public:
+  WindowStats();
+  ~WindowStats() {};
+
+  // Window lengths in seconds, e.g. "10,60"
+  bool setWindows(std::string spec);
+  // Depth band edges in meters, e.g. "5,10,25" gives the bands
+  // 0-5, 5-10, 10-25 and 25+
+  bool setDepthBands(std::string spec);
+
+  bool active() const  {return((m_windows.size() > 0) || (m_band_edges.size() > 0));};
+
+  // One step of step meters, ending at time t at the given depth
+  void addSample(double t, double step, double depth);
+
+  unsigned int sizeWindows() const  {return(m_windows.size());};
+  double getWindow(unsigned int i) const  {return(m_windows[i]);};
+  double getDistance(unsigned int i) const;
+  double getSpeed(unsigned int i) const;
+  double getPeakSpeed(unsigned int i) const  {return(m_peak_speed[i]);};
+
+  unsigned int sizeBands() const  {return(m_band_dist.size());};
+  std::string getBandName(unsigned int i) const;
+  double getBandDistance(unsigned int i) const  {return(m_band_dist[i].get());};
+
+  // e.g. dist_10=12.1,sog_10=1.21,dist_60=70.4,sog_60=1.17
+  std::string getWindowSummary() const;
+  // e.g. 0-5=1220.4,5-10=310.2,10-25=0,25+=0
+  std::string getBandSummary() const;
+
+  unsigned long getSamples() const  {return(m_next);};
+
+ protected:
+  struct Sample {
+    double t;
+    double cum;    // distance travelled up to and including this step
+  };
+
+  Sample& sample(unsigned long ix)  {return(m_ring[ix & m_mask]);};
+  const Sample& sample(unsigned long ix) const  {return(m_ring[ix & m_mask]);};
+  void grow();
+
+ private:
+  std::vector<Sample> m_ring;        // power-of-two size, grows if full
+  unsigned long m_mask;
+  unsigned long m_oldest;            // absolute index of oldest kept
+  unsigned long m_next;              // absolute index of next sample
+  double        m_cum;
+  double        m_first_time;
+
+  std::vector<double>        m_windows;
+  std::vector<unsigned long> m_start;       // oldest sample in window
+  std::vector<double>        m_peak_speed;
+
+  std::vector<double> m_band_edges;
+  std::vector<CompensatedSum> m_band_dist;
+};
+
+#endif
@@ -6,17 +6,32 @@
 /************************************************************/
 
 #include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
 #include "MBUtils.h"
 #include "ColorParse.h"
 #include "Odometry.h"
 #include "Odometry_Info.h"
+#include "LogReplay.h"
 
 using namespace std;
 
+int replayLogs(const vector<string>& log_files, double depth_thresh,
+               double noise_floor, const string& windows,
+               const string& depth_bands);
+
 int main(int argc, char *argv[])
 {
   string mission_file;
   string run_command = argv[0];
+  vector<string> log_files;
+  bool   replay = false;
+  double depth_thresh = 999999999;
+  double noise_floor = 0;
+  string windows;
+  string depth_bands;
 
   for(int i=1; i<argc; i++) {
     string argi = argv[i];
@@ -30,12 +45,27 @@ int main(int argc, char *argv[])
       showInterfaceAndExit();
     else if(strEnds(argi, ".moos") || strEnds(argi, ".moos++"))
       mission_file = argv[i];
+    else if((argi == "-r") || (argi == "--replay"))
+      replay = true;
+    else if(strEnds(argi, ".alog") || strEnds(argi, ".slog"))
+      log_files.push_back(argi);
+    else if(strBegins(argi, "--depth_thresh="))
+      depth_thresh = atof(argi.substr(15).c_str());
+    else if(strBegins(argi, "--noise_floor="))
+      noise_floor = atof(argi.substr(14).c_str());
+    else if(strBegins(argi, "--windows="))
+      windows = argi.substr(10);
+    else if(strBegins(argi, "--depth_bands="))
+      depth_bands = argi.substr(14);
     else if(strBegins(argi, "--alias="))
       run_command = argi.substr(8);
     else if(i==2)
       run_command = argi;
   }
   
+  if(replay || (log_files.size() > 0))
+    return(replayLogs(log_files, depth_thresh, noise_floor, windows, depth_bands));
+
   if(mission_file == "")
     showHelpAndExit();
 
@@ -50,3 +80,66 @@ int main(int argc, char *argv[])
   return(0);
 }
 
+//--------------------------------------------------------
+// Procedure: replayLogs()
+//   Purpose: Offline odometry for each log file, as fast as the
+//            file can be read.
+
+int replayLogs(const vector<string>& log_files, double depth_thresh,
+               double noise_floor, const string& windows,
+               const string& depth_bands)
+{
+  if(log_files.size() == 0) {
+    cout << "pOdometry --replay: no .alog or .slog files given" << endl;
+    return(1);
+  }
+
+  int result = 0;
+  for(unsigned int i=0; i<log_files.size(); i++) {
+    LogReplay replay;
+    replay.setDepthThresh(depth_thresh);
+    replay.setNoiseFloor(noise_floor);
+    WindowStats& stats = replay.getStats();
+    if((windows != "") && !stats.setWindows(windows)) {
+      cout << "Bad --windows: " << windows << endl;
+      return(1);
+    }
+    if((depth_bands != "") && !stats.setDepthBands(depth_bands)) {
+      cout << "Bad --depth_bands: " << depth_bands << endl;
+      return(1);
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool ok = replay.replay(log_files[i]);
+    chrono::duration<double> wall = chrono::steady_clock::now() - start;
+    if(!ok) {
+      cout << termColor("red") << replay.getError() << termColor() << endl;
+      result = 1;
+      continue;
+    }
+
+    const OdomTrack& track = replay.getTrack();
+    double mission_secs = replay.getEndTime() - replay.getStartTime();
+    cout << termColor("green") << log_files[i] << termColor() << endl;
+    printf("  distance:          %.2f m\n", track.getDistance());
+    if(depth_thresh < 999999999)
+      printf("  distance at depth: %.2f m (deeper than %g m)\n",
+             track.getDistanceAtDepth(), depth_thresh);
+    printf("  fixes:             %lu from %lu NAV samples\n",
+           track.getFixes(), replay.getNavSamples());
+    if(noise_floor > 0)
+      printf("  jitter dropped:    %lu steps under %g m\n", track.getFiltered(), noise_floor);
+    for(unsigned int j=0; j<stats.sizeWindows(); j++)
+      printf("  peak %gs speed:  %.2f m/s\n", stats.getWindow(j), stats.getPeakSpeed(j));
+    for(unsigned int j=0; j<stats.sizeBands(); j++)
+      printf("  depth %-10s  %.2f m\n", (stats.getBandName(j) + ":").c_str(),
+             stats.getBandDistance(j));
+    printf("  mission time:      %.1f s\n", mission_secs);
+    printf("  replay time:       %.3f s, %.0f MB/s", wall.count(),
+           replay.getBytes() / 1e6 / (wall.count() > 0 ? wall.count() : 1e-9));
+    if((wall.count() > 0) && (mission_secs > 0))
+      printf(", %.0fx real-time", mission_secs / wall.count());
+    printf("\n");
+  }
+  return(result);
+}
@@ -0,0 +1,423 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: AssignUtils.cpp                                 */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include "AssignUtils.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Procedure: distPts()
+
+double distPts(const AssignPt& a, const AssignPt& b)
+{
+  double dx = a.x - b.x;
+  double dy = a.y - b.y;
+  return(sqrt(dx*dx + dy*dy));
+}
+
+//---------------------------------------------------------
+// Procedure: convexHull()
+//   Purpose: Andrew's monotone chain.
+
+static double cross(const AssignPt& o, const AssignPt& a, const AssignPt& b)
+{
+  return((a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x));
+}
+
+vector<AssignPt> convexHull(const vector<AssignPt>& pts)
+{
+  vector<AssignPt> sorted = pts;
+  sort(sorted.begin(), sorted.end(),
+       [](const AssignPt& a, const AssignPt& b)
+       {return((a.x < b.x) || ((a.x == b.x) && (a.y < b.y)));});
+  if(sorted.size() < 3)
+    return(sorted);
+
+  unsigned int n = sorted.size();
+  vector<AssignPt> hull(2 * n);
+  unsigned int k = 0;
+  for(unsigned int i=0; i<n; i++) {
+    while((k >= 2) && (cross(hull[k-2], hull[k-1], sorted[i]) <= 0))
+      k--;
+    hull[k++] = sorted[i];
+  }
+  for(unsigned int i=n-1, t=k+1; i>0; i--) {
+    while((k >= t) && (cross(hull[k-2], hull[k-1], sorted[i-1]) <= 0))
+      k--;
+    hull[k++] = sorted[i-1];
+  }
+  hull.resize(k - 1);
+  return(hull);
+}
+
+//---------------------------------------------------------
+// Procedure: farthestSeeds()
+
+vector<AssignPt> farthestSeeds(const vector<AssignPt>& pts, unsigned int k)
+{
+  vector<AssignPt> seeds;
+  if(pts.empty() || (k == 0))
+    return(seeds);
+
+  vector<double> min_dist(pts.size(), -1);
+  unsigned int next = 0;
+  while(seeds.size() < k) {
+    seeds.push_back(pts[next]);
+    double far_dist = -1;
+    for(unsigned int i=0; i<pts.size(); i++) {
+      double dist = distPts(pts[i], seeds.back());
+      if((min_dist[i] < 0) || (dist < min_dist[i]))
+        min_dist[i] = dist;
+      if(min_dist[i] > far_dist) {
+        far_dist = min_dist[i];
+        next = i;
+      }
+    }
+  }
+  return(seeds);
+}
+
+//---------------------------------------------------------
+// Procedure: assignByCluster()
+//   Purpose: Balanced k-means. Each pass computes the distance from
+//            every point to every center, then hands points to their
+//            nearest center that still has room, most constrained
+//            points first (largest gap between best and second best
+//            center). Centers then move to the mean of their points.
+//            Stops when no point changes cluster.
+
+vector<unsigned int> assignByCluster(const vector<AssignPt>& pts,
+                                     const vector<AssignPt>& seeds,
+                                     unsigned int max_iters)
+{
+  unsigned int n = pts.size();
+  unsigned int k = seeds.size();
+
+  vector<unsigned int> labels(n, 0);
+  if((n == 0) || (k <= 1))
+    return(labels);
+
+  for(unsigned int i=0; i<n; i++)
+    labels[i] = k;
+
+  unsigned int cap = (n + k - 1) / k;
+
+  vector<AssignPt>     centers = seeds;
+  vector<double>       dist(n * k);
+  vector<double>       regret(n);
+  vector<unsigned int> order(n);
+  vector<unsigned int> load(k);
+
+  for(unsigned int iter=0; iter<max_iters; iter++) {
+    for(unsigned int i=0; i<n; i++) {
+      double best1 = -1;
+      double best2 = -1;
+      for(unsigned int c=0; c<k; c++) {
+        double d = distPts(pts[i], centers[c]);
+        dist[i*k + c] = d;
+        if((best1 < 0) || (d < best1)) {
+          best2 = best1;
+          best1 = d;
+        }
+        else if((best2 < 0) || (d < best2))
+          best2 = d;
+      }
+      regret[i] = best2 - best1;
+      order[i]  = i;
+    }
+
+    stable_sort(order.begin(), order.end(),
+                [&regret](unsigned int a, unsigned int b)
+                {return(regret[a] > regret[b]);});
+
+    fill(load.begin(), load.end(), 0);
+    bool changed = false;
+    for(unsigned int j=0; j<n; j++) {
+      unsigned int i = order[j];
+      unsigned int best_c = k;
+      for(unsigned int c=0; c<k; c++) {
+        if(load[c] >= cap)
+          continue;
+        if((best_c == k) || (dist[i*k + c] < dist[i*k + best_c]))
+          best_c = c;
+      }
+      if(labels[i] != best_c)
+        changed = true;
+      labels[i] = best_c;
+      load[best_c]++;
+    }
+
+    if(!changed)
+      break;
+
+    vector<AssignPt> sums(k);
+    for(unsigned int c=0; c<k; c++) {
+      sums[c].x = 0;
+      sums[c].y = 0;
+    }
+    for(unsigned int i=0; i<n; i++) {
+      sums[labels[i]].x += pts[i].x;
+      sums[labels[i]].y += pts[i].y;
+    }
+    for(unsigned int c=0; c<k; c++) {
+      if(load[c] == 0)
+        continue;
+      centers[c].x = sums[c].x / load[c];
+      centers[c].y = sums[c].y / load[c];
+    }
+  }
+
+  return(labels);
+}
+
+//---------------------------------------------------------
+// Procedure: tourLength()
+
+double tourLength(const vector<AssignPt>& pts, const AssignPt& start,
+                  const vector<unsigned int>& tour)
+{
+  double total = 0;
+  AssignPt prev = start;
+  for(unsigned int i=0; i<tour.size(); i++) {
+    total += distPts(prev, pts[tour[i]]);
+    prev = pts[tour[i]];
+  }
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: cheapestInsertion()
+//   Purpose: Find where in an open tour a point is cheapest to add.
+//            Position j means "insert before tour[j]"; j == size
+//            means append to the end.
+
+static double cheapestInsertion(const vector<AssignPt>& pts,
+                                const AssignPt& start,
+                                const vector<unsigned int>& tour,
+                                const AssignPt& pt, unsigned int& pos)
+{
+  pos = tour.size();
+  if(tour.empty())
+    return(distPts(start, pt));
+
+  double best = distPts(pts[tour.back()], pt);
+  AssignPt prev = start;
+  for(unsigned int j=0; j<tour.size(); j++) {
+    const AssignPt& next = pts[tour[j]];
+    double delta = distPts(prev, pt) + distPts(pt, next) - distPts(prev, next);
+    if(delta < best) {
+      best = delta;
+      pos  = j;
+    }
+    prev = next;
+  }
+  return(best);
+}
+
+//---------------------------------------------------------
+// Procedure: removalGain()
+//   Purpose: How much shorter a tour gets if tour[j] is dropped.
+
+static double removalGain(const vector<AssignPt>& pts, const AssignPt& start,
+                          const vector<unsigned int>& tour, unsigned int j)
+{
+  const AssignPt& prev = (j == 0) ? start : pts[tour[j-1]];
+  const AssignPt& curr = pts[tour[j]];
+  if(j+1 == tour.size())
+    return(distPts(prev, curr));
+  const AssignPt& next = pts[tour[j+1]];
+  return(distPts(prev, curr) + distPts(curr, next) - distPts(prev, next));
+}
+
+//---------------------------------------------------------
+// Procedure: swapDelta()
+//   Purpose: Change in a tour's length if tour[j] is replaced by pt.
+
+static double swapDelta(const vector<AssignPt>& pts, const AssignPt& start,
+                        const vector<unsigned int>& tour, unsigned int j,
+                        const AssignPt& pt)
+{
+  const AssignPt& prev = (j == 0) ? start : pts[tour[j-1]];
+  const AssignPt& curr = pts[tour[j]];
+  double delta = distPts(prev, pt) - distPts(prev, curr);
+  if(j+1 < tour.size()) {
+    const AssignPt& next = pts[tour[j+1]];
+    delta += distPts(pt, next) - distPts(curr, next);
+  }
+  return(delta);
+}
+
+//---------------------------------------------------------
+// Procedure: improveLongestTour()
+//   Purpose: Apply the single relocate or swap move off the longest
+//            tour that most reduces the longer of the two tours it
+//            touches. Returns false if no move lowers the longest.
+//      Note: Only the few shortest tours are tried as partners, which
+//            keeps a pass proportional to the two tour sizes rather
+//            than to the whole field.
+
+static bool improveLongestTour(const vector<AssignPt>& pts,
+                               const vector<AssignPt>& starts,
+                               vector<vector<unsigned int> >& tours,
+                               vector<double>& lens)
+{
+  unsigned int k = tours.size();
+  vector<unsigned int> by_len(k);
+  for(unsigned int v=0; v<k; v++)
+    by_len[v] = v;
+  sort(by_len.begin(), by_len.end(),
+       [&lens](unsigned int a, unsigned int b) {return(lens[a] < lens[b]);});
+
+  unsigned int a = by_len[k-1];
+  unsigned int partners = min(k-1, 3u);
+
+  vector<unsigned int>& tour_a = tours[a];
+  double best_max = lens[a] - 1e-9;
+  int    best_kind = 0;  // 1 relocate, 2 swap
+  unsigned int best_i = 0, best_b = 0, best_j = 0;
+  double best_len_a = 0, best_len_b = 0;
+
+  for(unsigned int i=0; i<tour_a.size(); i++) {
+    const AssignPt& pi = pts[tour_a[i]];
+    double gain = removalGain(pts, starts[a], tour_a, i);
+    for(unsigned int c=0; c<partners; c++) {
+      unsigned int b = by_len[c];
+      // Relocate tour_a[i] into tour b
+      unsigned int pos;
+      double delta = cheapestInsertion(pts, starts[b], tours[b], pi, pos);
+      double len_a = lens[a] - gain;
+      double len_b = lens[b] + delta;
+      if(max(len_a, len_b) < best_max) {
+        best_max = max(len_a, len_b);
+        best_kind = 1;
+        best_i = i; best_b = b; best_j = pos;
+        best_len_a = len_a; best_len_b = len_b;
+      }
+      // Swap tour_a[i] with each point of tour b
+      for(unsigned int j=0; j<tours[b].size(); j++) {
+        const AssignPt& pj = pts[tours[b][j]];
+        double swap_a = lens[a] + swapDelta(pts, starts[a], tour_a, i, pj);
+        double swap_b = lens[b] + swapDelta(pts, starts[b], tours[b], j, pi);
+        if(max(swap_a, swap_b) < best_max) {
+          best_max = max(swap_a, swap_b);
+          best_kind = 2;
+          best_i = i; best_b = b; best_j = j;
+          best_len_a = swap_a; best_len_b = swap_b;
+        }
+      }
+    }
+  }
+
+  if(best_kind == 0)
+    return(false);
+
+  if(best_kind == 1) {
+    unsigned int ix = tour_a[best_i];
+    tour_a.erase(tour_a.begin() + best_i);
+    tours[best_b].insert(tours[best_b].begin() + best_j, ix);
+  }
+  else
+    swap(tour_a[best_i], tours[best_b][best_j]);
+
+  lens[a] = best_len_a;
+  lens[best_b] = best_len_b;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: insertByTourBalance()
+
+void insertByTourBalance(const vector<AssignPt>& pts,
+                         const vector<AssignPt>& starts,
+                         const vector<unsigned int>& new_ixs,
+                         vector<vector<unsigned int> >& tours,
+                         vector<double>& tour_lens)
+{
+  unsigned int n = new_ixs.size();
+  unsigned int k = starts.size();
+  if((n == 0) || (k == 0))
+    return;
+
+  // Insert the points farthest from any start first, so the long
+  // legs are laid down before the tours fill in around them.
+  vector<double> reach(pts.size(), -1);
+  vector<unsigned int> order = new_ixs;
+  for(unsigned int j=0; j<n; j++) {
+    unsigned int i = new_ixs[j];
+    for(unsigned int v=0; v<k; v++) {
+      double d = distPts(pts[i], starts[v]);
+      if((reach[i] < 0) || (d < reach[i]))
+        reach[i] = d;
+    }
+  }
+  stable_sort(order.begin(), order.end(),
+              [&reach](unsigned int a, unsigned int b)
+              {return(reach[a] > reach[b]);});
+
+  for(unsigned int j=0; j<n; j++) {
+    unsigned int i = order[j];
+    unsigned int best_v = 0, best_pos = 0;
+    double best_len = -1, best_delta = 0;
+    for(unsigned int v=0; v<k; v++) {
+      unsigned int pos;
+      double delta = cheapestInsertion(pts, starts[v], tours[v], pts[i], pos);
+      double len = tour_lens[v] + delta;
+      if((best_len < 0) || (len < best_len) ||
+         ((len == best_len) && (delta < best_delta))) {
+        best_v = v;
+        best_pos = pos;
+        best_len = len;
+        best_delta = delta;
+      }
+    }
+    tours[best_v].insert(tours[best_v].begin() + best_pos, i);
+    tour_lens[best_v] = best_len;
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: assignByTourBalance()
+
+vector<unsigned int> assignByTourBalance(const vector<AssignPt>& pts,
+                                         const vector<AssignPt>& starts,
+                                         unsigned int max_moves,
+                                         vector<vector<unsigned int> >& tours,
+                                         vector<double>& tour_lens)
+{
+  unsigned int n = pts.size();
+  unsigned int k = starts.size();
+
+  vector<unsigned int> labels(n, 0);
+  tours.assign(k, vector<unsigned int>());
+  tour_lens.assign(k, 0);
+  if((n == 0) || (k == 0))
+    return(labels);
+
+  vector<unsigned int> all(n);
+  for(unsigned int i=0; i<n; i++)
+    all[i] = i;
+  insertByTourBalance(pts, starts, all, tours, tour_lens);
+
+  // Local improvement, bounded so large fields still finish promptly
+  if((max_moves > 0) && (k > 1)) {
+    for(unsigned int m=0; m<max_moves; m++) {
+      if(!improveLongestTour(pts, starts, tours, tour_lens))
+        break;
+    }
+    // Re-measure to shed accumulated rounding from the deltas
+    for(unsigned int v=0; v<k; v++)
+      tour_lens[v] = tourLength(pts, starts[v], tours[v]);
+  }
+
+  for(unsigned int v=0; v<k; v++) {
+    for(unsigned int j=0; j<tours[v].size(); j++)
+      labels[tours[v][j]] = v;
+  }
+  return(labels);
+}
@@ -0,0 +1,65 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: AssignUtils.h                                   */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+#ifndef ASSIGN_UTILS_HEADER
+#define ASSIGN_UTILS_HEADER
+
+#include <vector>
+
+// A bare position used by the assignment solvers. The solvers work
+// purely on indices into vectors of these and know nothing of MOOS.
+struct AssignPt {
+  double x;
+  double y;
+};
+
+double distPts(const AssignPt& a, const AssignPt& b);
+
+// Convex hull of the points, counter-clockwise, without repeating the
+// first vertex. Fewer than three distinct points come back as they are.
+std::vector<AssignPt> convexHull(const std::vector<AssignPt>& pts);
+
+// Pick k well spread seeds from the points (farthest-point seeding),
+// used when vehicle start positions are not known.
+std::vector<AssignPt> farthestSeeds(const std::vector<AssignPt>& pts,
+                                    unsigned int k);
+
+// Balanced k-means. Cluster i is seeded at seeds[i] and no cluster
+// may hold more than ceil(n/k) points. Returns the cluster index of
+// each point.
+std::vector<unsigned int> assignByCluster(const std::vector<AssignPt>& pts,
+                                          const std::vector<AssignPt>& seeds,
+                                          unsigned int max_iters=25);
+
+// Length of the open path that starts at start and visits the given
+// points in order.
+double tourLength(const std::vector<AssignPt>& pts, const AssignPt& start,
+                  const std::vector<unsigned int>& tour);
+
+// Add the points new_ixs (indices into pts) to existing open tours,
+// farthest from any start first, each into the tour that is shortest
+// after its cheapest insertion. tour_lens must hold the current tour
+// lengths and is kept up to date.
+void insertByTourBalance(const std::vector<AssignPt>& pts,
+                         const std::vector<AssignPt>& starts,
+                         const std::vector<unsigned int>& new_ixs,
+                         std::vector<std::vector<unsigned int> >& tours,
+                         std::vector<double>& tour_lens);
+
+// Min-max tour assignment. Points are inserted, farthest first, into
+// the vehicle whose tour would be shortest after its cheapest
+// insertion. Then up to max_moves points are moved or swapped off the
+// longest tour while that lowers the longest tour. Returns the vehicle
+// index of each point; tours and tour_lens receive the per-vehicle
+// visit order and estimated lengths.
+std::vector<unsigned int> assignByTourBalance(const std::vector<AssignPt>& pts,
+                                              const std::vector<AssignPt>& starts,
+                                              unsigned int max_moves,
+                                              std::vector<std::vector<unsigned int> >& tours,
+                                              std::vector<double>& tour_lens);
+
+#endif
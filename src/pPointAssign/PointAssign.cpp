@@ -11,7 +11,10 @@
 #include "MBUtils.h"
 #include "ACTable.h"
 #include "PointAssign.h"
+#include "PointBatch.h"
 #include "XYPoint.h"    // For visualization
+#include "XYSegList.h"
+#include "XYPolygon.h"
 
 using namespace std;
 
@@ -21,10 +24,39 @@ using namespace std;
 PointAssign::PointAssign()
 {
   // Initialize member variables
-  m_assign_by_region = false;
+  m_assign_mode = "alternating";
+  m_balance_moves = 200;
+  m_auction_batch = 0;
+  m_reauction_ratio = 1.5;
+  m_reauction_interval = 10;
+  m_visit_radius = 5;
+  m_last_reauction = 0;
+  m_reauctions = 0;
+  m_points_released = 0;
+  m_node_reports = 0;
+  m_batch_size = 0;
+  m_msgs_sent = 0;
+  m_batches_sent = 0;
+  m_reliable = false;
+  m_retransmit_timeout = 4;
+  m_retransmit_max = 60;
+  m_retransmit_burst = 10;
+  m_acks_recd = 0;
+  m_liveness_timeout = 0;
+  m_points_orphaned = 0;
+  m_view_mode = "points";
+  m_view_interval = 2;
+  m_view_dirty = false;
+  m_last_view_post = 0;
+  m_stream_window = 20;
+  m_stream_latency = 1;
+  m_stream_oldest = 0;
+  m_stream_windows = 0;
+  m_stream_max_wait = 0;
   m_points_received = 0;
   m_points_assigned = 0;
   m_first_point_sent = false;
+  m_last_point_recd = false;
   m_last_point_sent = false;
   
   m_vehicle_colors["HENRY"] = "yellow";
@@ -55,6 +87,12 @@ bool PointAssign::OnNewMail(MOOSMSG_LIST &NewMail)
       // New visit point received
       handleVisitPoint(sval);
     }
+    else if(key == "NODE_REPORT") {
+      handleNodeReport(sval);
+    }
+    else if(key == "VISIT_POINT_ACK") {
+      handleAck(sval);
+    }
     else if(key != "APPCAST_REQ") {
       reportRunWarning("Unhandled Mail: " + key);
     }
@@ -78,16 +116,36 @@ bool PointAssign::Iterate()
 {
   AppCastingMOOSApp::Iterate();
 
-  // If we have received all points but haven't sent "lastpoint" yet
-  if (m_points_to_assign.empty() && !m_last_point_sent && m_first_point_sent) {
+  if((m_liveness_timeout > 0) && m_first_point_sent)
+    checkLiveness();
+
+  if (m_assign_mode == "auction") {
+    checkReauction();
+    runAuction();
+  }
+
+  // Close a stream window whose oldest point has waited long enough
+  if(!m_stream_buffer.empty() &&
+     (m_last_point_recd || ((MOOSTime() - m_stream_oldest) >= m_stream_latency)))
+    flushStreamWindow();
+
+  // Points assigned since the last iteration go out before lastpoint
+  flushBatches();
+  if(m_reliable)
+    retransmitDue();
+
+  if(m_view_dirty && (m_view_mode != "points") &&
+     ((MOOSTime() - m_last_view_post) >= m_view_interval))
+    postAggregateView();
+
+  // If we have received and assigned all points but haven't sent
+  // "lastpoint" yet
+  if (m_points_to_assign.empty() && (m_auction.sizePending() == 0) &&
+      m_stream_buffer.empty() &&
+      m_last_point_recd && !m_last_point_sent && m_first_point_sent) {
     // Send "lastpoint" to all vehicles
     for (size_t i = 0; i < m_vehicle_names.size(); i++) {
-      string vname = (m_vehicle_names[i]);
-      string var_name = "VISIT_POINT_" + vname;
-      Notify(var_name, "lastpoint");
-      
-      //uFldShoreBroker sharing message with the vehicle
-      configureSharing(vname, "lastpoint");
+      sendToVehicle(m_vehicle_names[i], "lastpoint");
     }
     m_last_point_sent = true;
     reportEvent("Sent 'lastpoint' to all vehicles");
@@ -127,13 +185,88 @@ bool PointAssign::OnStartUp()
     else if(param == "assign_by_region") {
       // Set assignment method
       if(tolower(value) == "true") {
-        m_assign_by_region = true;
+        m_assign_mode = "region";
       }
       else {
-        m_assign_by_region = false;
+        m_assign_mode = "alternating";
       }
       handled = true;
     }
+    else if(param == "assign_mode") {
+      string mode = tolower(value);
+      if((mode == "alternating") || (mode == "region") ||
+         (mode == "cluster") || (mode == "balance") || (mode == "auction") ||
+         (mode == "stream")) {
+        m_assign_mode = mode;
+        handled = true;
+      }
+    }
+    else if(param == "balance_moves") {
+      handled = setUIntOnString(m_balance_moves, value);
+    }
+    else if(param == "batch_size") {
+      handled = setUIntOnString(m_batch_size, value);
+    }
+    else if(param == "reliable") {
+      handled = setBooleanOnString(m_reliable, value);
+    }
+    else if(param == "retransmit_timeout") {
+      handled = setPosDoubleOnString(m_retransmit_timeout, value);
+    }
+    else if(param == "retransmit_max") {
+      handled = setPosDoubleOnString(m_retransmit_max, value);
+    }
+    else if(param == "retransmit_burst") {
+      handled = setUIntOnString(m_retransmit_burst, value);
+    }
+    else if(param == "liveness_timeout") {
+      handled = setNonNegDoubleOnString(m_liveness_timeout, value);
+    }
+    else if(param == "stream_window") {
+      unsigned int window = 0;
+      if(setUIntOnString(window, value) && (window > 0)) {
+        m_stream_window = window;
+        handled = true;
+      }
+    }
+    else if(param == "stream_latency") {
+      handled = setPosDoubleOnString(m_stream_latency, value);
+    }
+    else if(param == "view_mode") {
+      string mode = tolower(value);
+      if((mode == "points") || (mode == "cloud") || (mode == "hull")) {
+        m_view_mode = mode;
+        handled = true;
+      }
+    }
+    else if(param == "view_interval") {
+      handled = setNonNegDoubleOnString(m_view_interval, value);
+    }
+    else if(param == "auction_batch") {
+      handled = setUIntOnString(m_auction_batch, value);
+    }
+    else if(param == "reauction_ratio") {
+      handled = setNonNegDoubleOnString(m_reauction_ratio, value);
+    }
+    else if(param == "reauction_interval") {
+      handled = setPosDoubleOnString(m_reauction_interval, value);
+    }
+    else if(param == "visit_radius") {
+      handled = setPosDoubleOnString(m_visit_radius, value);
+    }
+    else if(param == "vehicle_start") {
+      // vehicle_start = henry,161.2,3.8
+      string vname = toupper(biteStringX(value, ','));
+      string xstr  = biteStringX(value, ',');
+      string ystr  = value;
+      if(!vname.empty() && isNumber(xstr) && isNumber(ystr)) {
+        AssignPt start;
+        start.x = atof(xstr.c_str());
+        start.y = atof(ystr.c_str());
+        m_vehicle_starts[vname] = start;
+        handled = true;
+      }
+    }
     else if(param == "vehicle_color") {
       string vname = toupper(biteStringX(value, ','));
       string color = value;
@@ -152,6 +285,7 @@ bool PointAssign::OnStartUp()
   }
   else {
     string vnames = "";
+    m_auction.setVehicleCount(m_vehicle_names.size());
     for(size_t i=0; i<m_vehicle_names.size(); i++) {
       if(i > 0) vnames += ", ";
       vnames += m_vehicle_names[i];
@@ -166,18 +300,35 @@ bool PointAssign::OnStartUp()
       
       // Configure sharing for each vehicle
       setupSharingForVehicle(vname);
+      m_senders[vname].setTimeouts(m_retransmit_timeout, m_retransmit_max);
+
+      // Until a NODE_REPORT arrives, auction bids start from here
+      if(m_vehicle_starts.count(vname)) {
+        AssignPt start = m_vehicle_starts[vname];
+        m_auction.setVehiclePos(i, start.x, start.y);
+      }
     }
     reportEvent("Vehicle names: " + vnames);
   }
 
-  reportEvent("Assignment method: " + (m_assign_by_region ? string("By Region") : string("Alternating")));
+  reportEvent("Assignment method: " + m_assign_mode);
 
   // Visualize the east/west boundary if using region-based assignment
-  if(m_assign_by_region) {
+  if(m_assign_mode == "region") {
     // Draw a line at x=87.5 (the region boundary)
     double boundary_x = 87.5;
-    for(double y = -175; y <= -25; y += 15) {
-      postViewPoint(boundary_x, y, "boundary_" + doubleToStringX(y), "blue");
+    if(m_view_mode == "points") {
+      for(double y = -175; y <= -25; y += 15) {
+        postViewPoint(boundary_x, y, "boundary_" + doubleToStringX(y), "blue");
+      }
+    }
+    else {
+      XYSegList boundary;
+      boundary.add_vertex(boundary_x, -175);
+      boundary.add_vertex(boundary_x, -25);
+      boundary.set_label("boundary");
+      boundary.set_color("edge", "blue");
+      Notify("VIEW_SEGLIST", boundary.get_spec());
     }
     reportEvent("Visualized east/west boundary at x=87.5");
   }
@@ -193,6 +344,10 @@ void PointAssign::registerVariables()
 {
   AppCastingMOOSApp::RegisterVariables();
   Register("VISIT_POINT", 0);
+  if((m_assign_mode == "auction") || (m_liveness_timeout > 0))
+    Register("NODE_REPORT", 0);
+  if(m_reliable)
+    Register("VISIT_POINT_ACK", 0);
 }
 
 //---------------------------------------------------------
@@ -213,18 +368,65 @@ bool PointAssign::buildReport()
   }
   m_msgs << endl;
   
-  m_msgs << "  Assignment Method: " << (m_assign_by_region ? "By Region" : "Alternating") << endl;
+  m_msgs << "  Assignment Method: " << m_assign_mode << endl;
   m_msgs << "Statistics:" << endl;
   m_msgs << "  Points Received: " << m_points_received << endl;
   m_msgs << "  Points Assigned: " << m_points_assigned << endl;
+  m_msgs << "  Messages Sent:   " << m_msgs_sent;
+  if(m_batch_size > 0)
+    m_msgs << " (" << m_batches_sent << " batches of up to " << m_batch_size << ")";
+  m_msgs << endl;
+  if(m_reliable) {
+    m_msgs << "  Acks Received:   " << m_acks_recd << endl;
+    map<string, PointSender>::iterator q;
+    for(q=m_senders.begin(); q!=m_senders.end(); q++) {
+      m_msgs << "  " << q->first << ": " << q->second.sizeUnacked() << " unacked, ";
+      m_msgs << q->second.getRetransmits() << " resent" << endl;
+    }
+  }
   
   m_msgs << "Status:" << endl;
   m_msgs << "  First Point Sent: " << (m_first_point_sent ? "Yes" : "No") << endl;
   m_msgs << "  Last Point Sent: " << (m_last_point_sent ? "Yes" : "No") << endl;
   
+  if(m_assign_mode == "auction") {
+    m_msgs << "Auction:" << endl;
+    m_msgs << "  Pending Points: " << m_auction.sizePending() << endl;
+    m_msgs << "  Node Reports:   " << m_node_reports << endl;
+    m_msgs << "  Re-auctions:    " << m_reauctions << " (";
+    m_msgs << m_points_released << " points released)" << endl;
+    for(size_t i=0; i<m_vehicle_names.size(); i++) {
+      m_msgs << "  " << m_vehicle_names[i] << ": ";
+      m_msgs << m_auction.sizeUnvisited(i) << " unvisited, ";
+      m_msgs << doubleToStringX(m_auction.remainingWork(i), 1) << " m remaining";
+      if(!m_auction.hasVehiclePos(i))
+        m_msgs << " (no position yet)";
+      m_msgs << endl;
+    }
+  }
+
+  if(m_assign_mode == "stream") {
+    m_msgs << "Stream:" << endl;
+    m_msgs << "  Windows Placed: " << m_stream_windows << endl;
+    m_msgs << "  Buffered Now:   " << m_stream_buffer.size() << endl;
+    m_msgs << "  Longest Wait:   " << doubleToStringX(m_stream_max_wait, 2) << " secs" << endl;
+  }
+
+  if(m_liveness_timeout > 0) {
+    m_msgs << "Liveness:" << endl;
+    m_msgs << "  Vehicles Lost:  " << m_lost_vehicles.size() << endl;
+    m_msgs << "  Points Orphaned and Reassigned: " << m_points_orphaned << endl;
+  }
+
   m_msgs << "Points Per Vehicle:" << endl;
   for(map<string, int>::iterator it = m_points_per_vehicle.begin(); it != m_points_per_vehicle.end(); ++it) {
-    m_msgs << "  " << it->first << ": " << it->second << endl;
+    m_msgs << "  " << it->first << ": " << it->second;
+    m_msgs << " (" << m_open_points[it->first].size() << " open)";
+    if(isLost(it->first))
+      m_msgs << " LOST";
+    if(m_tour_estimates.count(it->first))
+      m_msgs << " (est. tour " << doubleToStringX(m_tour_estimates[it->first], 1) << " m)";
+    m_msgs << endl;
   }
   
   return(true);
@@ -235,11 +437,25 @@ bool PointAssign::buildReport()
 
 void PointAssign::handleVisitPoint(const string& point_str)
 {
-  // Increment received points counter
+  // The field markers are not points. We announce "firstpoint" to the
+  // vehicles ourselves, and "lastpoint" goes out once all the points
+  // received before it have been assigned.
+  if(point_str == "firstpoint")
+    return;
+  if(point_str == "lastpoint") {
+    m_last_point_recd = true;
+    processPointQueue();
+    return;
+  }
+
+  // Parse the point once and store it for later assignment
+  unsigned int ix = 0;
+  if(!m_store.add(point_str, MOOSTime(), ix)) {
+    reportRunWarning("Ignoring malformed or repeated VISIT_POINT: " + point_str);
+    return;
+  }
   m_points_received++;
-  
-  // Store the point for later assignment
-  m_points_to_assign.push_back(point_str);
+  m_points_to_assign.push_back(ix);
   
   // Process the queue of points to assign
   processPointQueue();
@@ -259,46 +475,64 @@ void PointAssign::processPointQueue()
   if(!m_first_point_sent) {
     for(size_t i=0; i<m_vehicle_names.size(); i++) {
       string vname = m_vehicle_names[i];
-      string var_name = "VISIT_POINT_" + vname;
-      Notify(var_name, "firstpoint");
-      
-      // Configure uFldShoreBroker to share this message with the vehicle
-      configureSharing(vname, "firstpoint");
+      sendToVehicle(vname, "firstpoint");
       
       // Initialize the points per vehicle counter
       m_points_per_vehicle[vname] = 0;
+
+      // A vehicle that never reports times out from here
+      if(!m_last_heard.count(vname))
+        m_last_heard[vname] = MOOSTime();
     }
     m_first_point_sent = true;
     reportEvent("Sent 'firstpoint' to all vehicles");
   }
   
+  // Auction mode hands the points to the auction, which awards them
+  // on the next iteration using the latest vehicle positions.
+  if(m_assign_mode == "auction") {
+    for(size_t i=0; i<m_points_to_assign.size(); i++) {
+      unsigned int ix = m_points_to_assign[i];
+      m_auction.addPoint(m_store.at(ix).pos.x, m_store.at(ix).pos.y);
+      m_auction_points.push_back(ix);
+    }
+    m_points_to_assign.clear();
+    return;
+  }
+
+  // Stream mode holds points until the window fills or its oldest
+  // point has waited stream_latency, then places them together.
+  if(m_assign_mode == "stream") {
+    for(size_t i=0; i<m_points_to_assign.size(); i++) {
+      unsigned int ix = m_points_to_assign[i];
+      if(m_stream_buffer.empty())
+        m_stream_oldest = m_store.at(ix).arrival;
+      m_stream_buffer.push_back(ix);
+      if(m_stream_buffer.size() >= m_stream_window)
+        flushStreamWindow();
+    }
+    m_points_to_assign.clear();
+    return;
+  }
+
+  // Clustering and tour balancing need the whole field, so hold
+  // points until the "lastpoint" marker has been received.
+  if((m_assign_mode == "cluster") || (m_assign_mode == "balance")) {
+    if(m_last_point_recd)
+      assignQueueJointly();
+    return;
+  }
+
   // Process all points in the queue
-  while(!m_points_to_assign.empty()) {
-    string point_str = m_points_to_assign.front();
-    m_points_to_assign.pop_front();
+  for(size_t i=0; i<m_points_to_assign.size(); i++) {
+    unsigned int ix = m_points_to_assign[i];
     
     // Determine which vehicle should get this point
     string vehicle_name;
     
-    // Extract coordinates and ID from the point string
-    double x = 0, y = 0;
-    string id = "";
-    
-    // Parse the point string to extract x, y, and id
-    vector<string> parts = parseString(point_str, ',');
-    for(size_t i=0; i<parts.size(); i++) {
-      string part = stripBlankEnds(parts[i]);
-      if(strBegins(part, "x="))
-        x = atof(part.substr(2).c_str());
-      else if(strBegins(part, "y="))
-        y = atof(part.substr(2).c_str());
-      else if(strBegins(part, "id="))
-        id = part.substr(3);
-    }
-    
-    if(m_assign_by_region) {
+    if(m_assign_mode == "region") {
       // Assign by region (east-west)
-      if(x < 87.5) {
+      if(m_store.at(ix).pos.x < 87.5) {
         // West region
         vehicle_name = m_vehicle_names[0];
       } else {
@@ -309,26 +543,557 @@ void PointAssign::processPointQueue()
       // Assign alternating
       vehicle_name = m_vehicle_names[m_points_assigned % m_vehicle_names.size()];
     }
-    
-    // Visualize the point assignment using the appropriate vehicle color
-    string color = m_vehicle_colors[vehicle_name];
-    postViewPoint(x, y, "visit_" + id, color);
-    
-    // Send the point to the selected vehicle
-    string var_name = "VISIT_POINT_" + vehicle_name;
-    Notify(var_name, point_str);
-    
-    // Configure uFldShoreBroker to share this message with the vehicle
-    configureSharing(vehicle_name, point_str);
-    
-    // Update counters
-    m_points_assigned++;
-    m_points_per_vehicle[vehicle_name]++;
-    
-    reportEvent("Assigned point to " + vehicle_name + ": " + point_str);
+
+    assignPoint(vehicle_name, ix);
+  }
+  m_points_to_assign.clear();
+}
+
+//---------------------------------------------------------
+// Procedure: assignQueueJointly
+//   Purpose: Assign the whole field at once. In cluster mode each
+//            vehicle gets one compact region from balanced k-means
+//            seeded at the vehicle start positions. In balance mode
+//            points go wherever they keep the longest estimated tour
+//            shortest.
+
+void PointAssign::assignQueueJointly()
+{
+  vector<unsigned int> ixs = m_points_to_assign;
+  m_points_to_assign.clear();
+
+  vector<AssignPt> pts(ixs.size());
+  for(size_t i=0; i<ixs.size(); i++)
+    pts[i] = m_store.at(ixs[i]).pos;
+
+  vector<AssignPt> seeds = getVehicleSeeds(pts);
+  vector<unsigned int> labels;
+  if(m_assign_mode == "cluster")
+    labels = assignByCluster(pts, seeds);
+  else {
+    vector<vector<unsigned int> > tours;
+    vector<double> tour_lens;
+    labels = assignByTourBalance(pts, seeds, m_balance_moves, tours, tour_lens);
+    for(size_t v=0; v<tour_lens.size(); v++)
+      m_tour_estimates[m_vehicle_names[v]] = tour_lens[v];
+  }
+
+  for(size_t i=0; i<ixs.size(); i++)
+    assignPoint(m_vehicle_names[labels[i]], ixs[i]);
+  reportEvent("Assigned " + uintToString(pts.size()) + " points jointly (" +
+              m_assign_mode + ") to " + uintToString(seeds.size()) + " vehicles");
+}
+
+//---------------------------------------------------------
+// Procedure: getVehicleSeeds
+//   Purpose: One seed per vehicle, in vehicle order. Vehicles with a
+//            configured start position use it; the rest are filled
+//            with points spread as far apart as possible.
+
+vector<AssignPt> PointAssign::getVehicleSeeds(const vector<AssignPt>& pts)
+{
+  vector<AssignPt> spread = farthestSeeds(pts, m_vehicle_names.size());
+
+  vector<AssignPt> seeds;
+  unsigned int next_spread = 0;
+  for(size_t i=0; i<m_vehicle_names.size(); i++) {
+    map<string, AssignPt>::iterator p = m_vehicle_starts.find(m_vehicle_names[i]);
+    if(p != m_vehicle_starts.end())
+      seeds.push_back(p->second);
+    else if(next_spread < spread.size())
+      seeds.push_back(spread[next_spread++]);
+  }
+  return(seeds);
+}
+
+//---------------------------------------------------------
+// Procedure: handleNodeReport
+//   Purpose: Track vehicle liveness and positions, and note any
+//            assigned points a vehicle has now passed within
+//            visit_radius of.
+
+void PointAssign::handleNodeReport(const string& report)
+{
+  string vname = toupper(tokStringParse(report, "NAME", ',', '='));
+  int vix = vehicleIndex(vname);
+  if(vix < 0)
+    return;
+
+  double x = 0, y = 0;
+  if(!tokParse(report, "X", ',', '=', x) || !tokParse(report, "Y", ',', '=', y))
+    return;
+
+  m_node_reports++;
+  m_last_heard[vname] = MOOSTime();
+  m_vehicle_pos[vname].x = x;
+  m_vehicle_pos[vname].y = y;
+
+  if(isLost(vname)) {
+    m_lost_vehicles.erase(vname);
+    m_auction.setVehicleActive(vix, true);
+    reportEvent(vname + " is reporting again and may be assigned new points");
+  }
+
+  vector<unsigned int>& open = m_open_points[vname];
+  for(unsigned int i=0; i<open.size(); ) {
+    PointRecord& rec = m_store.at(open[i]);
+    double dx = rec.pos.x - x;
+    double dy = rec.pos.y - y;
+    if(((dx*dx) + (dy*dy)) <= (m_visit_radius * m_visit_radius)) {
+      rec.visited = true;
+      open.erase(open.begin() + i);
+      m_view_dirty = true;
+    }
+    else
+      i++;
+  }
+
+  m_auction.setVehiclePos(vix, x, y);
+  m_auction.markVisited(vix, m_visit_radius);
+}
+
+//---------------------------------------------------------
+// Procedure: checkLiveness
+
+void PointAssign::checkLiveness()
+{
+  double curr_time = MOOSTime();
+  for(size_t i=0; i<m_vehicle_names.size(); i++) {
+    string vname = m_vehicle_names[i];
+    if(isLost(vname) || !m_last_heard.count(vname))
+      continue;
+    if((curr_time - m_last_heard[vname]) > m_liveness_timeout)
+      handleVehicleLoss(vname);
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: handleVehicleLoss
+//   Purpose: Hand the unvisited points of a vehicle that has stopped
+//            reporting to the vehicles still running. Only those
+//            points are moved; nobody else's assignment changes.
+
+void PointAssign::handleVehicleLoss(const string& vname)
+{
+  if(m_lost_vehicles.size() + 1 >= m_vehicle_names.size()) {
+    reportRunWarning(vname + " silent but no other vehicle left to take its points");
+    m_last_heard[vname] = MOOSTime();
+    return;
+  }
+
+  m_lost_vehicles.insert(vname);
+  vector<unsigned int> orphans = m_open_points[vname];
+  reportRunWarning(vname + " lost: no NODE_REPORT in " +
+                   doubleToStringX(m_liveness_timeout, 1) + " secs");
+
+  // Points still held for its next batch must not go out after the
+  // drop, or they would end up assigned twice
+  m_batch_buffer.erase(vname);
+
+  // Tell the lost vehicle to forget its points, in case it returns
+  if(!orphans.empty())
+    sendDrops(vname, orphans);
+  m_points_orphaned += orphans.size();
+  if(!orphans.empty())
+    reportEvent("Reassigning " + uintToString(orphans.size()) +
+                " open points of " + vname);
+
+  // The auction takes the points back and re-awards them next round
+  if(m_assign_mode == "auction") {
+    int vix = vehicleIndex(vname);
+    m_auction.setVehicleActive(vix, false);
+    m_auction.releaseAll(vix);
+    return;
+  }
+
+  placePoints(orphans);
+}
+
+//---------------------------------------------------------
+// Procedure: flushStreamWindow
+//   Purpose: Place the buffered window of points jointly into the
+//            vehicles' open tours.
+
+void PointAssign::flushStreamWindow()
+{
+  if(m_stream_buffer.empty())
+    return;
+
+  double wait = MOOSTime() - m_stream_oldest;
+  if(wait > m_stream_max_wait)
+    m_stream_max_wait = wait;
+
+  placePoints(m_stream_buffer);
+  m_stream_buffer.clear();
+  m_stream_windows++;
+}
+
+//---------------------------------------------------------
+// Procedure: placePoints
+//   Purpose: Fold points into the open tours of the live vehicles,
+//            each into the tour that stays shortest after its
+//            cheapest insertion, and send each vehicle only the
+//            points it gains. Open points are kept in tour order so
+//            later insertions build on the same tours.
+
+void PointAssign::placePoints(const vector<unsigned int>& new_ixs)
+{
+  vector<string>   vnames;
+  vector<AssignPt> starts;
+  vector<AssignPt> pts;
+  vector<unsigned int> all_ixs;
+  vector<vector<unsigned int> > tours;
+  vector<double>   tour_lens;
+
+  for(size_t i=0; i<m_vehicle_names.size(); i++) {
+    string vname = m_vehicle_names[i];
+    if(isLost(vname))
+      continue;
+
+    const vector<unsigned int>& open = m_open_points[vname];
+    vector<unsigned int> tour;
+    for(size_t j=0; j<open.size(); j++) {
+      tour.push_back(pts.size());
+      pts.push_back(m_store.at(open[j]).pos);
+      all_ixs.push_back(open[j]);
+    }
+
+    AssignPt start;
+    start.x = 0;
+    start.y = 0;
+    if(m_vehicle_pos.count(vname))
+      start = m_vehicle_pos[vname];
+    else if(m_vehicle_starts.count(vname))
+      start = m_vehicle_starts[vname];
+    else if(!open.empty())
+      start = pts[tour[0]];
+
+    vnames.push_back(vname);
+    starts.push_back(start);
+    tour_lens.push_back(tourLength(pts, start, tour));
+    tours.push_back(tour);
+  }
+  if(vnames.empty())
+    return;
+
+  unsigned int first_new = pts.size();
+  vector<unsigned int> new_locals;
+  for(size_t i=0; i<new_ixs.size(); i++) {
+    new_locals.push_back(pts.size());
+    pts.push_back(m_store.at(new_ixs[i]).pos);
+    all_ixs.push_back(new_ixs[i]);
+  }
+  insertByTourBalance(pts, starts, new_locals, tours, tour_lens);
+
+  for(size_t v=0; v<vnames.size(); v++) {
+    for(size_t j=0; j<tours[v].size(); j++) {
+      if(tours[v][j] >= first_new)
+        assignPoint(vnames[v], all_ixs[tours[v][j]]);
+    }
+
+    vector<unsigned int> ordered;
+    for(size_t j=0; j<tours[v].size(); j++)
+      ordered.push_back(all_ixs[tours[v][j]]);
+    m_open_points[vnames[v]] = ordered;
+    m_tour_estimates[vnames[v]] = tour_lens[v];
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: vehicleIndex
+
+int PointAssign::vehicleIndex(const string& vname) const
+{
+  for(size_t i=0; i<m_vehicle_names.size(); i++) {
+    if(m_vehicle_names[i] == vname)
+      return(i);
+  }
+  return(-1);
+}
+
+//---------------------------------------------------------
+// Procedure: runAuction
+//   Purpose: Award up to auction_batch pending points and send each
+//            to its winning vehicle. With no active vehicle to bid,
+//            the points are held, and lastpoint with them, until one
+//            reports again.
+
+void PointAssign::runAuction()
+{
+  if(m_auction.sizePending() == 0)
+    return;
+
+  string warning = "Auction holding points: no active vehicle to bid";
+  if(m_auction.sizeActive() == 0) {
+    reportRunWarning(warning);
+    return;
+  }
+  retractRunWarning(warning);
+
+  vector<pair<unsigned int, unsigned int> > awards;
+  awards = m_auction.runRound(m_auction_batch);
+  for(size_t i=0; i<awards.size(); i++) {
+    unsigned int ix = m_auction_points[awards[i].first];
+    assignPoint(m_vehicle_names[awards[i].second], ix);
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: checkReauction
+//   Purpose: If a vehicle's remaining work has fallen well behind
+//            the fleet mean, take back its most recently awarded
+//            unvisited points so the next round re-auctions them.
+
+void PointAssign::checkReauction()
+{
+  if((m_reauction_ratio <= 0) || !m_first_point_sent)
+    return;
+  double curr_time = MOOSTime();
+  if((curr_time - m_last_reauction) < m_reauction_interval)
+    return;
+  m_last_reauction = curr_time;
+
+  unsigned int amt = m_vehicle_names.size();
+  unsigned int active = 0;
+  double total = 0;
+  for(unsigned int v=0; v<amt; v++) {
+    if(!m_auction.isVehicleActive(v))
+      continue;
+    total += m_auction.remainingWork(v);
+    active++;
+  }
+  if(active < 2)
+    return;
+  double mean = total / active;
+  if(mean <= 0)
+    return;
+
+  for(unsigned int v=0; v<amt; v++) {
+    if(m_auction.remainingWork(v) <= (m_reauction_ratio * mean))
+      continue;
+    vector<unsigned int> released = m_auction.releaseTail(v, mean);
+    if(released.empty())
+      continue;
+    vector<unsigned int> ixs;
+    for(size_t i=0; i<released.size(); i++)
+      ixs.push_back(m_auction_points[released[i]]);
+    sendDrops(m_vehicle_names[v], ixs);
+    m_reauctions++;
+    m_points_released += released.size();
+    reportEvent("Re-auctioning " + uintToString(released.size()) +
+                " points from " + m_vehicle_names[v]);
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: sendDrops
+//   Purpose: Tell a vehicle to forget points it no longer owns.
+//   Example: VISIT_POINT_HENRY = "drop=7:12:31"
+
+void PointAssign::sendDrops(const string& vname, const vector<unsigned int>& ixs)
+{
+  string drop_str = "drop=";
+  set<unsigned int> dropped;
+  for(size_t i=0; i<ixs.size(); i++) {
+    if(i > 0)
+      drop_str += ":";
+    drop_str += m_store.at(ixs[i]).id;
+    m_store.at(ixs[i]).vehicle = -1;
+    dropped.insert(ixs[i]);
+  }
+
+  sendToVehicle(vname, drop_str);
+
+  vector<unsigned int>& open = m_open_points[vname];
+  for(unsigned int i=0; i<open.size(); ) {
+    if(dropped.count(open[i]))
+      open.erase(open.begin() + i);
+    else
+      i++;
+  }
+
+  m_points_assigned -= ixs.size();
+  m_points_per_vehicle[vname] -= ixs.size();
+  m_view_dirty = true;
+}
+
+//---------------------------------------------------------
+// Procedure: assignPoint
+//   Purpose: Send one point to the given vehicle, draw it in the
+//            vehicle color and update the counters.
+
+void PointAssign::assignPoint(const string& vname, unsigned int ix)
+{
+  // A lost vehicle gets nothing new; place the point with the others
+  if(isLost(vname)) {
+    placePoints(vector<unsigned int>(1, ix));
+    return;
+  }
+
+  PointRecord& rec = m_store.at(ix);
+  rec.vehicle = vehicleIndex(vname);
+
+  // Visualize the point assignment using the appropriate vehicle
+  // color, either now or in the next aggregated update
+  if(m_view_mode == "points")
+    postViewPoint(rec.pos.x, rec.pos.y, "visit_" + rec.id, m_vehicle_colors[vname]);
+  else
+    m_view_dirty = true;
+
+  // Send the point to the selected vehicle, or hold it for the next
+  // batch if batching
+  if(m_batch_size > 0)
+    m_batch_buffer[vname].push_back(ix);
+  else if(m_reliable) {
+    PointBatchRef batch;
+    batch.ixs.push_back(ix);
+    sendFramed(vname, batch);
+  }
+  else
+    postToVehicle(vname, rec.spec);
+
+  m_open_points[vname].push_back(ix);
+
+  // Update counters
+  m_points_assigned++;
+  m_points_per_vehicle[vname]++;
+
+  if(m_view_mode == "points")
+    reportEvent("Assigned point to " + vname + ": " + rec.spec);
+}
+
+//---------------------------------------------------------
+// Procedure: sendToVehicle
+//   Purpose: Post one VISIT_POINT_<VNAME> message for the shore broker
+//            to bridge to the vehicle.
+
+void PointAssign::sendToVehicle(const string& vname, const string& msg)
+{
+  if(m_reliable) {
+    PointBatchRef batch;
+    batch.control = msg;
+    sendFramed(vname, batch);
+  }
+  else
+    postToVehicle(vname, msg);
+}
+
+//---------------------------------------------------------
+// Procedure: sendFramed
+//   Purpose: Send a batch with its own sequence number. With reliable
+//            delivery it is kept until the vehicle acks it.
+
+void PointAssign::sendFramed(const string& vname, const PointBatchRef& batch)
+{
+  unsigned int seq = ++m_batch_seq[vname];
+  string msg = buildPointBatch(seq, batchItems(batch), m_reliable);
+  postToVehicle(vname, msg);
+  if(m_reliable) {
+    m_senders[vname].addSent(seq, MOOSTime());
+    m_sent_batches[vname][seq] = batch;
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: batchItems
+//   Purpose: The item strings of a batch, the points taken from the
+//            store as received so a resend matches the first send.
+
+vector<string> PointAssign::batchItems(const PointBatchRef& batch) const
+{
+  vector<string> items;
+  if(batch.control != "")
+    items.push_back(batch.control);
+  for(unsigned int i=0; i<batch.ixs.size(); i++)
+    items.push_back(m_store.at(batch.ixs[i]).spec);
+  return(items);
+}
+
+//---------------------------------------------------------
+// Procedure: postToVehicle
+
+void PointAssign::postToVehicle(const string& vname, const string& msg)
+{
+  Notify("VISIT_POINT_" + vname, msg);
+
+  // Configure uFldShoreBroker to share this message with the vehicle
+  configureSharing(vname, msg);
+  m_msgs_sent++;
+}
+
+//---------------------------------------------------------
+// Procedure: flushBatches
+//   Purpose: Send each vehicle's held points in messages of up to
+//            batch_size points, each with its own sequence number.
+
+void PointAssign::flushBatches()
+{
+  map<string, vector<unsigned int> >::iterator p;
+  for(p=m_batch_buffer.begin(); p!=m_batch_buffer.end(); p++) {
+    string vname = p->first;
+    const vector<unsigned int>& held = p->second;
+    for(unsigned int i=0; i<held.size(); i+=m_batch_size) {
+      unsigned int j = i + m_batch_size;
+      if(j > held.size())
+        j = held.size();
+      PointBatchRef chunk;
+      chunk.ixs.assign(held.begin() + i, held.begin() + j);
+      sendFramed(vname, chunk);
+      m_batches_sent++;
+    }
+  }
+  m_batch_buffer.clear();
+}
+
+//---------------------------------------------------------
+// Procedure: retransmitDue
+//   Purpose: Resend the batches each vehicle has not acked in time,
+//            at most retransmit_burst per vehicle per iteration.
+
+void PointAssign::retransmitDue()
+{
+  double curr_time = MOOSTime();
+  map<string, PointSender>::iterator p;
+  for(p=m_senders.begin(); p!=m_senders.end(); p++) {
+    string vname = p->first;
+    if(isLost(vname))
+      continue;
+    vector<unsigned int> due = p->second.getDue(curr_time, m_retransmit_burst);
+    for(unsigned int i=0; i<due.size(); i++) {
+      const PointBatchRef& batch = m_sent_batches[vname][due[i]];
+      postToVehicle(vname, buildPointBatch(due[i], batchItems(batch), true));
+    }
   }
 }
 
+//---------------------------------------------------------
+// Procedure: handleAck
+//   Example: "vname=henry,cum=12,sack=14:16"
+
+void PointAssign::handleAck(const string& ack)
+{
+  string vname;
+  unsigned int cum = 0;
+  vector<unsigned int> sacks;
+  if(!parsePointAck(ack, vname, cum, sacks)) {
+    reportRunWarning("Malformed VISIT_POINT_ACK: " + ack);
+    return;
+  }
+
+  vname = toupper(vname);
+  if(!m_senders.count(vname))
+    return;
+  m_senders[vname].handleAck(cum, sacks, MOOSTime());
+  m_acks_recd++;
+
+  // Forget the batches just acknowledged, as the sender has
+  map<unsigned int, PointBatchRef>& sent = m_sent_batches[vname];
+  while(!sent.empty() && (sent.begin()->first <= cum))
+    sent.erase(sent.begin());
+  for(unsigned int i=0; i<sacks.size(); i++)
+    sent.erase(sacks[i]);
+}
+
 //---------------------------------------------------------
 // Procedure: setupSharingForVehicle
 
@@ -367,3 +1132,65 @@ void PointAssign::postViewPoint(double x, double y, string label, string color)
   reportEvent("Posted view point: " + label + " at x=" + doubleToStringX(x) + ", y=" + doubleToStringX(y) + ", color=" + color);
 }
 
+//---------------------------------------------------------
+// Procedure: postAggregateView
+//   Purpose: Draw each vehicle's open points in a few messages rather
+//            than one VIEW_POINT per point. In cloud mode the points
+//            are the vertices of edgeless seglists of up to 500
+//            points. In hull mode each vehicle gets the convex hull
+//            of its open points as one polygon.
+
+void PointAssign::postAggregateView()
+{
+  const unsigned int chunk_size = 500;
+
+  for(size_t i=0; i<m_vehicle_names.size(); i++) {
+    string vname = m_vehicle_names[i];
+    string color = m_vehicle_colors[vname];
+    const vector<unsigned int>& open = m_open_points[vname];
+
+    if(m_view_mode == "hull") {
+      vector<AssignPt> pts(open.size());
+      for(size_t j=0; j<open.size(); j++)
+        pts[j] = m_store.at(open[j]).pos;
+      vector<AssignPt> hull = convexHull(pts);
+
+      XYPolygon poly;
+      for(size_t j=0; j<hull.size(); j++)
+        poly.add_vertex(hull[j].x, hull[j].y, false);
+      poly.set_label("region_" + vname);
+      poly.set_color("edge", color);
+      poly.set_color("vertex", color);
+      poly.set_param("vertex_size", "4");
+      poly.set_active(hull.size() >= 3);
+      Notify("VIEW_POLYGON", poly.get_spec());
+      continue;
+    }
+
+    unsigned int chunks = 0;
+    for(size_t j=0; j<open.size(); j+=chunk_size) {
+      XYSegList cloud;
+      for(size_t k=j; (k<open.size()) && (k<j+chunk_size); k++)
+        cloud.add_vertex(m_store.at(open[k]).pos.x, m_store.at(open[k]).pos.y);
+      cloud.set_label("points_" + vname + "_" + uintToString(chunks));
+      cloud.set_color("edge", "invisible");
+      cloud.set_color("vertex", color);
+      cloud.set_param("vertex_size", "4");
+      Notify("VIEW_SEGLIST", cloud.get_spec());
+      chunks++;
+    }
+
+    // Erase chunks left over from a larger cloud
+    for(unsigned int c=chunks; c<m_view_chunks[vname]; c++) {
+      XYSegList stale;
+      stale.add_vertex(0, 0);
+      stale.set_label("points_" + vname + "_" + uintToString(c));
+      stale.set_active(false);
+      Notify("VIEW_SEGLIST", stale.get_spec());
+    }
+    m_view_chunks[vname] = chunks;
+  }
+
+  m_view_dirty = false;
+  m_last_view_post = MOOSTime();
+}
@@ -10,10 +10,22 @@
 
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
 #include "XYPoint.h"  // Added for visualization
+#include "AssignUtils.h"
+#include "PointAuction.h"
+#include "PointLink.h"
+#include "PointStore.h"
 #include <string>
 #include <vector>
-#include <list>
 #include <map>
+#include <set>
+
+// One framed batch for a vehicle: points by store index, or a single
+// control item (firstpoint, lastpoint or drop=...). Reliable batches
+// are kept this way until acked and rebuilt from the store to resend.
+struct PointBatchRef {
+  std::vector<unsigned int> ixs;
+  std::string control;
+};
 
 class PointAssign : public AppCastingMOOSApp
 {
@@ -33,25 +45,109 @@ class PointAssign : public AppCastingMOOSApp
  protected:
    void registerVariables();
    void handleVisitPoint(const std::string& point_str);
+   void handleNodeReport(const std::string& report);
+   void handleAck(const std::string& ack);
    void processPointQueue();
+   void assignQueueJointly();
+   void assignPoint(const std::string& vname, unsigned int ix);
+   std::vector<AssignPt> getVehicleSeeds(const std::vector<AssignPt>& pts);
+   int  vehicleIndex(const std::string& vname) const;
+   void runAuction();
+   void checkReauction();
+   void sendDrops(const std::string& vname, const std::vector<unsigned int>& ixs);
+   void checkLiveness();
+   void handleVehicleLoss(const std::string& vname);
+   void placePoints(const std::vector<unsigned int>& new_ixs);
+   void flushStreamWindow();
+   bool isLost(const std::string& vname) const {return(m_lost_vehicles.count(vname) > 0);};
    void setupSharingForVehicle(const std::string& vname);
    void configureSharing(const std::string& vname, const std::string& point_str);
+   void sendToVehicle(const std::string& vname, const std::string& msg);
+   void sendFramed(const std::string& vname, const PointBatchRef& batch);
+   std::vector<std::string> batchItems(const PointBatchRef& batch) const;
+   void postToVehicle(const std::string& vname, const std::string& msg);
+   void flushBatches();
+   void retransmitDue();
    
    // New method for visualization
    void postViewPoint(double x, double y, std::string label, std::string color);
+   void postAggregateView();
 
  private: // Configuration variables
    std::vector<std::string> m_vehicle_names;
-   bool m_assign_by_region;
+   std::string m_assign_mode;  // alternating, region, cluster, balance,
+                               // auction or stream
+   unsigned int m_balance_moves;  // improvement moves in balance mode
+   unsigned int m_auction_batch;  // points awarded per iteration, 0=all
+   double m_reauction_ratio;      // re-auction a vehicle whose remaining
+                                  // work exceeds this multiple of mean
+   double m_reauction_interval;   // seconds between re-auction checks
+   double m_visit_radius;         // meters, for visits seen in NODE_REPORT
+   unsigned int m_batch_size;     // points per VISIT_POINT msg, 0=no batching
+   bool   m_reliable;             // sequence and acknowledge every message
+   double m_retransmit_timeout;   // secs before first resend
+   double m_retransmit_max;       // secs, cap on the doubling timeout
+   unsigned int m_retransmit_burst;  // resends per vehicle per iterate
+   double m_liveness_timeout;     // secs without NODE_REPORT, 0=off
+   std::string m_view_mode;       // points, cloud or hull
+   double m_view_interval;        // secs between cloud/hull updates
+   unsigned int m_stream_window;  // points per window in stream mode
+   double m_stream_latency;       // secs a point may wait in stream mode
    std::map<std::string, std::string> m_vehicle_colors; // Color for each vehicle
+   std::map<std::string, AssignPt> m_vehicle_starts;    // Seeds for clustering
 
  private: // State variables
-   std::list<std::string> m_points_to_assign;
+   // Every point received. The lists below hold indices into it.
+   PointStore m_store;
+
+   std::vector<unsigned int> m_points_to_assign;
    int m_points_received;
    int m_points_assigned;
    bool m_first_point_sent;
+   bool m_last_point_recd;
    bool m_last_point_sent;
    std::map<std::string, int> m_points_per_vehicle;
+   std::map<std::string, double> m_tour_estimates;  // meters, per vehicle
+
+   // Points assigned but not yet sent, and the last batch sequence
+   // number sent, per vehicle (batching only)
+   std::map<std::string, std::vector<unsigned int> > m_batch_buffer;
+   std::map<std::string, unsigned int> m_batch_seq;
+   unsigned int m_msgs_sent;
+   unsigned int m_batches_sent;
+
+   // Unacknowledged batches per vehicle (reliable delivery only)
+   std::map<std::string, PointSender> m_senders;
+   std::map<std::string, std::map<unsigned int, PointBatchRef> > m_sent_batches;
+   unsigned int m_acks_recd;
+
+   // Auction mode state. Point index i in the auction refers to
+   // m_store point m_auction_points[i].
+   PointAuction m_auction;
+   std::vector<unsigned int> m_auction_points;
+   double m_last_reauction;
+   unsigned int m_reauctions;
+   unsigned int m_points_released;
+   unsigned int m_node_reports;
+
+   // Vehicle liveness, and the points each vehicle still has to visit
+   std::map<std::string, double>   m_last_heard;
+   std::map<std::string, AssignPt> m_vehicle_pos;
+   std::set<std::string>           m_lost_vehicles;
+   std::map<std::string, std::vector<unsigned int> > m_open_points;
+   unsigned int m_points_orphaned;
+
+   // Stream mode: points waiting for their window to close
+   std::vector<unsigned int> m_stream_buffer;
+   double m_stream_oldest;
+   unsigned int m_stream_windows;
+   double m_stream_max_wait;
+
+   // Aggregated visualization: whether open points changed since the
+   // last post, and how many seglists each vehicle's cloud used
+   bool   m_view_dirty;
+   double m_last_view_post;
+   std::map<std::string, unsigned int> m_view_chunks;
 };
 
 #endif
\ No newline at end of file
@@ -74,6 +74,36 @@ void showExampleConfigAndExit()
   blk("  AppTick   = 4                                                 ");
   blk("  CommsTick = 4                                                 ");
   blk("                                                                ");
+  blk("  vname         = henry          // one line per vehicle        ");
+  blk("  vname         = gilda                                         ");
+  blk("  vehicle_color = henry,yellow                                  ");
+  blk("                                                                ");
+  blk("  assign_mode   = alternating    // or region, cluster,         ");
+  blk("                                 //    balance, auction, stream   ");
+  blk("  vehicle_start = henry,161.2,3.8  // seed / tour start (opt)   ");
+  blk("  balance_moves = 200            // balance mode improvement    ");
+  blk("  batch_size    = 0              // points per message, 0=off   ");
+  blk("  stream_window  = 20            // stream mode: points per window");
+  blk("  stream_latency = 1             // stream mode: max secs a point ");
+  blk("                                 //   waits before it is placed  ");
+  blk("  view_mode     = points         // or cloud, hull              ");
+  blk("  view_interval = 2              // secs between cloud/hull posts");
+  blk("                                                                ");
+  blk("  reliable           = false // sequence and ack every message   ");
+  blk("  retransmit_timeout = 4     // secs, doubles on each resend     ");
+  blk("  retransmit_max     = 60    // secs, cap on the timeout         ");
+  blk("  retransmit_burst   = 10    // resends per vehicle per iterate  ");
+  blk("                                                                ");
+  blk("  auction_batch      = 0     // points awarded per iterate, 0=all");
+  blk("                             // held, with a run warning, while  ");
+  blk("                             // no vehicle is active to bid      ");
+  blk("  reauction_ratio    = 1.5   // vs. mean remaining work, 0=off   ");
+  blk("  reauction_interval = 10    // secs between re-auction checks   ");
+  blk("  visit_radius       = 5     // meters                           ");
+  blk("                                                                ");
+  blk("  liveness_timeout   = 0     // secs without a NODE_REPORT before");
+  blk("                             // a vehicle's open points move to  ");
+  blk("                             // the others, 0=off                ");
   blk("}                                                               ");
   blk("                                                                ");
   exit(0);
@@ -94,12 +124,23 @@ void showInterfaceAndExit()
   blk("                                                                ");
   blk("SUBSCRIPTIONS:                                                  ");
   blk("------------------------------------                            ");
-  blk("  NODE_MESSAGE = src_node=alpha,dest_node=bravo,var_name=FOO,   ");
-  blk("                 string_val=BAR                                 ");
+  blk("  VISIT_POINT = firstpoint, lastpoint, or x=12,y=-40,id=7       ");
+  blk("  NODE_REPORT = NAME=henry,X=12,Y=-40,...  (auction mode, or    ");
+  blk("                liveness_timeout > 0)                           ");
+  blk("  VISIT_POINT_ACK = vname=henry,cum=12,sack=14:16  (reliable)   ");
   blk("                                                                ");
   blk("PUBLICATIONS:                                                   ");
   blk("------------------------------------                            ");
-  blk("  Publications are determined by the node message content.      ");
+  blk("  VISIT_POINT_<VNAME> = firstpoint, lastpoint, or a point       ");
+  blk("                        drop=7:12:31 (auction re-assignments)   ");
+  blk("                        batch=4,n=2,sum=5cef0715;x=1,y=2,id=7;  ");
+  blk("                          x=5,y=9,id=8  (when batch_size > 0)   ");
+  blk("                        With reliable = true every message is   ");
+  blk("                        sent as a batch with ack=1 set.         ");
+  blk("  USR_BROKER_CONFIG   = ROUTE = VISIT_POINT_<VNAME>,...         ");
+  blk("  VIEW_POINT          = assigned point in the vehicle color     ");
+  blk("  VIEW_SEGLIST        = open points per vehicle (view_mode=cloud)");
+  blk("  VIEW_POLYGON        = hull of open points (view_mode=hull)    ");
   blk("                                                                ");
   exit(0);
 }
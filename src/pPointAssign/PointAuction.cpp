@@ -0,0 +1,431 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: PointAuction.cpp                                */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+#include <cmath>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include "PointAuction.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Constructor()
+
+PointAuction::PointAuction()
+{
+  m_pending   = 0;
+  m_grid_x0   = 0;
+  m_grid_y0   = 0;
+  m_grid_cell = 1;
+  m_grid_nx   = 0;
+  m_grid_ny   = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: setVehicleCount()
+
+void PointAuction::setVehicleCount(unsigned int amt)
+{
+  AssignPt origin;
+  origin.x = 0;
+  origin.y = 0;
+  m_pos.resize(amt, origin);
+  m_pos_known.resize(amt, false);
+  m_active.resize(amt, true);
+  m_queue.resize(amt);
+  m_legs.resize(amt, 0);
+}
+
+//---------------------------------------------------------
+// Procedure: setVehiclePos()
+
+void PointAuction::setVehiclePos(unsigned int vix, double x, double y)
+{
+  if(vix >= m_pos.size())
+    return;
+  m_pos[vix].x = x;
+  m_pos[vix].y = y;
+  m_pos_known[vix] = true;
+}
+
+//---------------------------------------------------------
+// Procedure: hasVehiclePos()
+
+bool PointAuction::hasVehiclePos(unsigned int vix) const
+{
+  if(vix >= m_pos_known.size())
+    return(false);
+  return(m_pos_known[vix]);
+}
+
+//---------------------------------------------------------
+// Procedure: setVehicleActive()
+
+void PointAuction::setVehicleActive(unsigned int vix, bool active)
+{
+  if(vix < m_active.size())
+    m_active[vix] = active;
+}
+
+//---------------------------------------------------------
+// Procedure: isVehicleActive()
+
+bool PointAuction::isVehicleActive(unsigned int vix) const
+{
+  if(vix >= m_active.size())
+    return(false);
+  return(m_active[vix]);
+}
+
+//---------------------------------------------------------
+// Procedure: sizeActive()
+
+unsigned int PointAuction::sizeActive() const
+{
+  unsigned int count = 0;
+  for(unsigned int v=0; v<m_active.size(); v++) {
+    if(m_active[v])
+      count++;
+  }
+  return(count);
+}
+
+//---------------------------------------------------------
+// Procedure: addPoint()
+
+unsigned int PointAuction::addPoint(double x, double y)
+{
+  AssignPt pt;
+  pt.x = x;
+  pt.y = y;
+  m_pts.push_back(pt);
+  m_owner.push_back(-1);
+  m_visited.push_back(false);
+  m_pending++;
+  return(m_pts.size() - 1);
+}
+
+//---------------------------------------------------------
+// Procedure: runRound()
+
+vector<pair<unsigned int, unsigned int> > PointAuction::runRound(unsigned int max_awards)
+{
+  vector<pair<unsigned int, unsigned int> > awards;
+  if((m_pending == 0) || m_pos.empty())
+    return(awards);
+
+  buildGrid();
+
+  // Vehicles not yet heard from bid from the middle of the field
+  AssignPt centroid;
+  centroid.x = m_grid_x0 + (m_grid_nx * m_grid_cell) / 2;
+  centroid.y = m_grid_y0 + (m_grid_ny * m_grid_cell) / 2;
+  for(unsigned int v=0; v<m_pos.size(); v++) {
+    if(!m_pos_known[v])
+      m_pos[v] = centroid;
+  }
+
+  // Each heap entry is one vehicle's current best bid
+  typedef pair<double, pair<unsigned int, unsigned int> > Bid;
+  priority_queue<Bid, vector<Bid>, greater<Bid> > bids;
+
+  for(unsigned int v=0; v<m_pos.size(); v++) {
+    if(!m_active[v])
+      continue;
+    unsigned int pix;
+    if(nearestPending(queueEnd(v), pix)) {
+      double bid = remainingWork(v) + distPts(queueEnd(v), m_pts[pix]);
+      bids.push(make_pair(bid, make_pair(v, pix)));
+    }
+  }
+
+  while(!bids.empty()) {
+    if((max_awards > 0) && (awards.size() >= max_awards))
+      break;
+
+    unsigned int v   = bids.top().second.first;
+    unsigned int pix = bids.top().second.second;
+    bids.pop();
+
+    // Award the point unless another vehicle won it since this bid
+    // was placed, then place this vehicle's next bid
+    if(m_owner[pix] < 0) {
+      double step = distPts(queueEnd(v), m_pts[pix]);
+      if(!m_queue[v].empty())
+        m_legs[v] += step;
+      m_queue[v].push_back(pix);
+      m_owner[pix] = v;
+      m_pending--;
+      removeFromGrid(pix);
+      awards.push_back(make_pair(pix, v));
+    }
+
+    unsigned int next;
+    if(nearestPending(queueEnd(v), next)) {
+      double bid = remainingWork(v) + distPts(queueEnd(v), m_pts[next]);
+      bids.push(make_pair(bid, make_pair(v, next)));
+    }
+  }
+  return(awards);
+}
+
+//---------------------------------------------------------
+// Procedure: markVisited()
+//   Purpose: Retire any queued point the vehicle is now within the
+//            given radius of. Returns the number newly visited.
+
+unsigned int PointAuction::markVisited(unsigned int vix, double radius)
+{
+  if(vix >= m_queue.size())
+    return(0);
+
+  vector<unsigned int>& queue = m_queue[vix];
+  unsigned int amt = 0;
+  for(unsigned int i=0; i<queue.size(); ) {
+    unsigned int pix = queue[i];
+    if(distPts(m_pos[vix], m_pts[pix]) <= radius) {
+      m_visited[pix] = true;
+      queue.erase(queue.begin() + i);
+      amt++;
+    }
+    else
+      i++;
+  }
+  if(amt > 0)
+    updateLegs(vix);
+  return(amt);
+}
+
+//---------------------------------------------------------
+// Procedure: releaseTail()
+//   Purpose: Return the most recently awarded unvisited points of a
+//            vehicle to the pending pool until its remaining work is
+//            no more than target_work. The first queued point is
+//            always kept.
+
+vector<unsigned int> PointAuction::releaseTail(unsigned int vix, double target_work)
+{
+  vector<unsigned int> released;
+  if(vix >= m_queue.size())
+    return(released);
+
+  vector<unsigned int>& queue = m_queue[vix];
+  while((queue.size() > 1) && (remainingWork(vix) > target_work)) {
+    unsigned int pix = queue.back();
+    queue.pop_back();
+    m_legs[vix] -= distPts(m_pts[queue.back()], m_pts[pix]);
+    m_owner[pix] = -1;
+    m_pending++;
+    released.push_back(pix);
+  }
+  return(released);
+}
+
+//---------------------------------------------------------
+// Procedure: releaseAll()
+//   Purpose: Return every unvisited point of a vehicle to the pending
+//            pool, e.g. when the vehicle has been lost.
+
+vector<unsigned int> PointAuction::releaseAll(unsigned int vix)
+{
+  vector<unsigned int> released;
+  if(vix >= m_queue.size())
+    return(released);
+
+  released = m_queue[vix];
+  for(unsigned int i=0; i<released.size(); i++)
+    m_owner[released[i]] = -1;
+  m_pending += released.size();
+  m_queue[vix].clear();
+  m_legs[vix] = 0;
+  return(released);
+}
+
+//---------------------------------------------------------
+// Procedure: remainingWork()
+//   Purpose: Distance from the vehicle to its first queued point
+//            plus the queue length after that, in award order.
+
+double PointAuction::remainingWork(unsigned int vix) const
+{
+  if((vix >= m_queue.size()) || m_queue[vix].empty())
+    return(0);
+  return(distPts(m_pos[vix], m_pts[m_queue[vix][0]]) + m_legs[vix]);
+}
+
+//---------------------------------------------------------
+// Procedure: sizeUnvisited()
+
+unsigned int PointAuction::sizeUnvisited(unsigned int vix) const
+{
+  if(vix >= m_queue.size())
+    return(0);
+  return(m_queue[vix].size());
+}
+
+//---------------------------------------------------------
+// Procedure: getOwner()
+
+int PointAuction::getOwner(unsigned int pix) const
+{
+  if(pix >= m_owner.size())
+    return(-1);
+  return(m_owner[pix]);
+}
+
+//---------------------------------------------------------
+// Procedure: isVisited()
+
+bool PointAuction::isVisited(unsigned int pix) const
+{
+  if(pix >= m_visited.size())
+    return(false);
+  return(m_visited[pix]);
+}
+
+//---------------------------------------------------------
+// Procedure: queueEnd()
+
+const AssignPt& PointAuction::queueEnd(unsigned int vix) const
+{
+  if(m_queue[vix].empty())
+    return(m_pos[vix]);
+  return(m_pts[m_queue[vix].back()]);
+}
+
+//---------------------------------------------------------
+// Procedure: updateLegs()
+
+void PointAuction::updateLegs(unsigned int vix)
+{
+  const vector<unsigned int>& queue = m_queue[vix];
+  m_legs[vix] = 0;
+  for(unsigned int i=1; i<queue.size(); i++)
+    m_legs[vix] += distPts(m_pts[queue[i-1]], m_pts[queue[i]]);
+}
+
+//---------------------------------------------------------
+// Procedure: buildGrid()
+//   Purpose: Bucket the pending points into square cells sized so
+//            there is about one point per cell.
+
+void PointAuction::buildGrid()
+{
+  double xmin = 0, xmax = 0, ymin = 0, ymax = 0;
+  bool first = true;
+  for(unsigned int i=0; i<m_pts.size(); i++) {
+    if(m_owner[i] >= 0)
+      continue;
+    const AssignPt& pt = m_pts[i];
+    if(first || (pt.x < xmin)) xmin = pt.x;
+    if(first || (pt.x > xmax)) xmax = pt.x;
+    if(first || (pt.y < ymin)) ymin = pt.y;
+    if(first || (pt.y > ymax)) ymax = pt.y;
+    first = false;
+  }
+
+  double area = (xmax - xmin) * (ymax - ymin);
+  m_grid_cell = sqrt(area / (m_pending + 1));
+  if(m_grid_cell < 1)
+    m_grid_cell = 1;
+
+  m_grid_x0 = xmin;
+  m_grid_y0 = ymin;
+  m_grid_nx = (int)((xmax - xmin) / m_grid_cell) + 1;
+  m_grid_ny = (int)((ymax - ymin) / m_grid_cell) + 1;
+
+  m_cells.assign(m_grid_nx * m_grid_ny, vector<unsigned int>());
+  for(unsigned int i=0; i<m_pts.size(); i++) {
+    if(m_owner[i] >= 0)
+      continue;
+    int cx, cy;
+    cellOf(m_pts[i], cx, cy);
+    m_cells[cellIndex(cx, cy)].push_back(i);
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: cellOf()
+
+void PointAuction::cellOf(const AssignPt& pt, int& cx, int& cy) const
+{
+  cx = (int)floor((pt.x - m_grid_x0) / m_grid_cell);
+  cy = (int)floor((pt.y - m_grid_y0) / m_grid_cell);
+  cx = max(0, min(cx, m_grid_nx - 1));
+  cy = max(0, min(cy, m_grid_ny - 1));
+}
+
+//---------------------------------------------------------
+// Procedure: removeFromGrid()
+
+void PointAuction::removeFromGrid(unsigned int pix)
+{
+  int cx, cy;
+  cellOf(m_pts[pix], cx, cy);
+  vector<unsigned int>& cell = m_cells[cellIndex(cx, cy)];
+  for(unsigned int i=0; i<cell.size(); i++) {
+    if(cell[i] == pix) {
+      cell[i] = cell.back();
+      cell.pop_back();
+      return;
+    }
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: nearestPending()
+//   Purpose: Search rings of cells outward from the query. Once the
+//            best distance is below what any farther ring could hold
+//            the search stops. A query outside the grid is clamped
+//            onto it, and the clamp offset is charged to the bound.
+
+bool PointAuction::nearestPending(const AssignPt& pt, unsigned int& pix) const
+{
+  if(m_pending == 0)
+    return(false);
+
+  AssignPt clamped = pt;
+  clamped.x = max(m_grid_x0, min(pt.x, m_grid_x0 + m_grid_nx * m_grid_cell));
+  clamped.y = max(m_grid_y0, min(pt.y, m_grid_y0 + m_grid_ny * m_grid_cell));
+  double offset = distPts(pt, clamped);
+
+  int cx, cy;
+  cellOf(clamped, cx, cy);
+
+  bool   found = false;
+  double best  = 0;
+  int    max_ring = max(m_grid_nx, m_grid_ny);
+  for(int r=0; r<=max_ring; r++) {
+    for(int dy=-r; dy<=r; dy++) {
+      int y = cy + dy;
+      if((y < 0) || (y >= m_grid_ny))
+        continue;
+      // Interior rows of the ring only have the two end cells
+      int step = ((dy == -r) || (dy == r)) ? 1 : 2*r;
+      if(step == 0)
+        step = 1;
+      for(int dx=-r; dx<=r; dx+=step) {
+        int x = cx + dx;
+        if((x < 0) || (x >= m_grid_nx))
+          continue;
+        const vector<unsigned int>& cell = m_cells[cellIndex(x, y)];
+        for(unsigned int i=0; i<cell.size(); i++) {
+          double dist = distPts(pt, m_pts[cell[i]]);
+          if(!found || (dist < best)) {
+            found = true;
+            best  = dist;
+            pix   = cell[i];
+          }
+        }
+      }
+    }
+    if(found && (best <= (r * m_grid_cell) - offset))
+      break;
+  }
+  return(found);
+}
@@ -0,0 +1,83 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: PointAuction.h                                  */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+#ifndef POINT_AUCTION_HEADER
+#define POINT_AUCTION_HEADER
+
+#include <vector>
+#include <utility>
+#include "AssignUtils.h"
+
+// Market-based point assignment. Each vehicle bids on a point with the
+// work it still has queued plus the cost of appending the point to the
+// end of its queue. Rounds award the cheapest bids one at a time, and
+// after each award only the winner's bid needs recomputing, which is a
+// nearest-pending-point query on a uniform grid.
+
+class PointAuction
+{
+ public:
+  PointAuction();
+  ~PointAuction() {};
+
+  void setVehicleCount(unsigned int amt);
+  void setVehiclePos(unsigned int vix, double x, double y);
+  bool hasVehiclePos(unsigned int vix) const;
+  void setVehicleActive(unsigned int vix, bool active);
+  bool isVehicleActive(unsigned int vix) const;
+  unsigned int sizeActive() const;
+
+  unsigned int addPoint(double x, double y);
+
+  // Award up to max_awards pending points (0 means all). Returns the
+  // (point, vehicle) pairs in award order. Points stay pending while
+  // no vehicle is active or the fleet is empty.
+  std::vector<std::pair<unsigned int, unsigned int> > runRound(unsigned int max_awards);
+
+  unsigned int markVisited(unsigned int vix, double radius);
+  std::vector<unsigned int> releaseTail(unsigned int vix, double target_work);
+  std::vector<unsigned int> releaseAll(unsigned int vix);
+
+  double remainingWork(unsigned int vix) const;
+  unsigned int sizeUnvisited(unsigned int vix) const;
+  unsigned int sizePending() const  {return(m_pending);};
+  unsigned int sizePoints() const   {return(m_pts.size());};
+  int  getOwner(unsigned int pix) const;
+  bool isVisited(unsigned int pix) const;
+
+ protected:
+  void   buildGrid();
+  bool   nearestPending(const AssignPt& pt, unsigned int& pix) const;
+  void   removeFromGrid(unsigned int pix);
+  void   updateLegs(unsigned int vix);
+  const AssignPt& queueEnd(unsigned int vix) const;
+  unsigned int cellIndex(int cx, int cy) const  {return(cy * m_grid_nx + cx);};
+  void   cellOf(const AssignPt& pt, int& cx, int& cy) const;
+
+ private: // Per point state
+  std::vector<AssignPt> m_pts;
+  std::vector<int>      m_owner;    // -1 while pending
+  std::vector<bool>     m_visited;
+  unsigned int          m_pending;
+
+ private: // Per vehicle state
+  std::vector<AssignPt> m_pos;
+  std::vector<bool>     m_pos_known;
+  std::vector<bool>     m_active;   // inactive vehicles do not bid
+  std::vector<std::vector<unsigned int> > m_queue;  // unvisited, award order
+  std::vector<double>   m_legs;     // length of the queue after its first point
+
+ private: // Grid over the pending points
+  double m_grid_x0;
+  double m_grid_y0;
+  double m_grid_cell;
+  int    m_grid_nx;
+  int    m_grid_ny;
+  std::vector<std::vector<unsigned int> > m_cells;
+};
+
+#endif
@@ -0,0 +1,75 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: PointStore.cpp                                  */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+#include <cstdlib>
+#include "MBUtils.h"
+#include "PointStore.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Procedure: add()
+
+bool PointStore::add(const string& spec, double arrival, unsigned int& ix)
+{
+  PointRecord rec;
+  rec.pos.x = 0;
+  rec.pos.y = 0;
+  if(!parsePointSpec(spec, rec.pos.x, rec.pos.y, rec.id))
+    return(false);
+  unsigned int prev_ix;
+  if((rec.id != "") && findId(rec.id, prev_ix))
+    return(false);
+
+  rec.spec    = spec;
+  rec.arrival = arrival;
+  rec.vehicle = -1;
+  rec.visited = false;
+
+  ix = m_recs.size();
+  m_recs.push_back(rec);
+  if(rec.id != "")
+    m_id_index[rec.id] = ix;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: findId()
+
+bool PointStore::findId(const string& id, unsigned int& ix) const
+{
+  map<string, unsigned int>::const_iterator p = m_id_index.find(id);
+  if(p == m_id_index.end())
+    return(false);
+  ix = p->second;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: parsePointSpec()
+
+bool parsePointSpec(const string& spec, double& x, double& y, string& id)
+{
+  bool got_x = false;
+  bool got_y = false;
+
+  vector<string> parts = parseString(spec, ',');
+  for(size_t i=0; i<parts.size(); i++) {
+    string part = stripBlankEnds(parts[i]);
+    if(strBegins(part, "x=")) {
+      x = atof(part.substr(2).c_str());
+      got_x = true;
+    }
+    else if(strBegins(part, "y=")) {
+      y = atof(part.substr(2).c_str());
+      got_y = true;
+    }
+    else if(strBegins(part, "id="))
+      id = part.substr(3);
+  }
+  return(got_x && got_y);
+}
@@ -0,0 +1,56 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: PointStore.h                                    */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+#ifndef POINT_STORE_HEADER
+#define POINT_STORE_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+#include "AssignUtils.h"
+
+// One visit point, parsed once when it arrives
+struct PointRecord {
+  AssignPt    pos;
+  std::string id;
+  std::string spec;     // the VISIT_POINT string as received, forwarded as is
+  double      arrival;  // time received
+  int         vehicle;  // index into the vehicle names, -1 if unassigned
+  bool        visited;
+};
+
+// All points received, in arrival order, in one contiguous vector.
+// Everything else refers to a point by its index here. Ids are
+// indexed so a point heard twice is stored once; the vehicles drop
+// points by id, so two points may not share one.
+
+class PointStore
+{
+ public:
+  PointStore() {};
+  ~PointStore() {};
+
+  // Returns false, storing nothing, if the spec has no x or y or its
+  // id is already stored
+  bool add(const std::string& spec, double arrival, unsigned int& ix);
+  bool findId(const std::string& id, unsigned int& ix) const;
+
+  PointRecord&       at(unsigned int ix)       {return(m_recs[ix]);};
+  const PointRecord& at(unsigned int ix) const {return(m_recs[ix]);};
+
+  unsigned int size() const {return(m_recs.size());};
+
+ private:
+  std::vector<PointRecord> m_recs;
+  std::map<std::string, unsigned int> m_id_index;
+};
+
+// Example: "x=12.5, y=-40, id=7"
+bool parsePointSpec(const std::string& spec, double& x, double& y,
+                    std::string& id);
+
+#endif
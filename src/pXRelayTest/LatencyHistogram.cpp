@@ -0,0 +1,143 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: LatencyHistogram.cpp                                 */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#include "MBUtils.h"
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+static const unsigned int  SUB_BITS    = 5;
+static const unsigned long SUB_BUCKETS = 1UL << SUB_BITS;
+static const unsigned int  MAGNITUDES  = 33;    // up to 2^37 usecs
+
+//---------------------------------------------------------
+// Constructor
+
+LatencyHistogram::LatencyHistogram()
+{
+  reset();
+}
+
+//---------------------------------------------------------
+// Procedure: reset()
+
+void LatencyHistogram::reset()
+{
+  m_counts.assign(MAGNITUDES * SUB_BUCKETS, 0);
+  m_count = 0;
+  m_total = 0;
+  m_min   = 0;
+  m_max   = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: bucketIndex()
+//   Purpose: Values below SUB_BUCKETS get a bucket each. Above that,
+//            the top SUB_BITS bits below the leading one pick the
+//            sub-bucket within the value's power of two.
+
+unsigned int LatencyHistogram::bucketIndex(unsigned long usecs) const
+{
+  if(usecs < SUB_BUCKETS)
+    return(usecs);
+
+  unsigned int msb = 63 - __builtin_clzl(usecs);
+  unsigned int magnitude = msb - SUB_BITS + 1;
+  if(magnitude >= MAGNITUDES)
+    return(m_counts.size() - 1);
+
+  unsigned long sub = (usecs >> (msb - SUB_BITS)) & (SUB_BUCKETS - 1);
+  return(magnitude * SUB_BUCKETS + sub);
+}
+
+//---------------------------------------------------------
+// Procedure: bucketValue()
+//   Purpose: The largest value that falls in the bucket
+
+unsigned long LatencyHistogram::bucketValue(unsigned int ix) const
+{
+  unsigned int  magnitude = ix / SUB_BUCKETS;
+  unsigned long sub = ix % SUB_BUCKETS;
+  if(magnitude == 0)
+    return(sub);
+
+  unsigned int shift = magnitude - 1;
+  unsigned long lower = (SUB_BUCKETS + sub) << shift;
+  return(lower + (1UL << shift) - 1);
+}
+
+//---------------------------------------------------------
+// Procedure: record()
+
+void LatencyHistogram::record(double secs)
+{
+  if(secs < 0)
+    secs = 0;
+
+  unsigned long usecs = (unsigned long)(secs * 1e6 + 0.5);
+  m_counts[bucketIndex(usecs)]++;
+
+  if((m_count == 0) || (secs < m_min))
+    m_min = secs;
+  if(secs > m_max)
+    m_max = secs;
+  m_total += secs;
+  m_count++;
+}
+
+//---------------------------------------------------------
+// Procedure: getPercentile()
+
+double LatencyHistogram::getPercentile(double pct) const
+{
+  if(m_count == 0)
+    return(0);
+
+  unsigned long target = (unsigned long)((pct / 100.0) * m_count + 0.5);
+  if(target < 1)
+    target = 1;
+
+  unsigned long seen = 0;
+  for(unsigned int i=0; i<m_counts.size(); i++) {
+    seen += m_counts[i];
+    if(seen >= target) {
+      double secs = bucketValue(i) / 1e6;
+      return((secs < m_max) ? secs : m_max);
+    }
+  }
+  return(m_max);
+}
+
+//---------------------------------------------------------
+// Procedure: getSummary()
+
+string LatencyHistogram::getSummary() const
+{
+  string summary = "n=" + uintToString(m_count);
+  summary += ",min="   + doubleToString(getMin() * 1000, 2);
+  summary += ",p50="   + doubleToString(getPercentile(50) * 1000, 2);
+  summary += ",p90="   + doubleToString(getPercentile(90) * 1000, 2);
+  summary += ",p99="   + doubleToString(getPercentile(99) * 1000, 2);
+  summary += ",p99.9=" + doubleToString(getPercentile(99.9) * 1000, 2);
+  summary += ",max="   + doubleToString(getMax() * 1000, 2);
+  return(summary);
+}
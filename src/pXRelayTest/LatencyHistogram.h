@@ -0,0 +1,70 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: LatencyHistogram.h                                   */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#ifndef LATENCY_HISTOGRAM_HEADER
+#define LATENCY_HISTOGRAM_HEADER
+
+#include <string>
+#include <vector>
+
+// HDR-style latency histogram. Values are kept in microseconds in
+// log-linear buckets: each power of two is split into 32 sub-buckets,
+// so any value is known to within about 3% over the full range from
+// 1 microsecond to over an hour, in a fixed 8K of counters. Recording
+// is O(1) with no allocation.
+
+class LatencyHistogram
+{
+ public:
+  LatencyHistogram();
+  ~LatencyHistogram() {};
+
+  // Record a latency given in seconds. Negative values count as zero.
+  void record(double secs);
+  void reset();
+
+  // Latency in seconds at or below which pct percent of values fall
+  double getPercentile(double pct) const;
+
+  unsigned long getCount() const  {return(m_count);};
+  double getMin() const   {return(m_count ? m_min : 0);};
+  double getMax() const   {return(m_max);};
+  double getMean() const  {return(m_count ? m_total / m_count : 0);};
+
+  // n=1200,min=0.41,p50=0.98,p90=1.60,p99=2.84,p99.9=6.02,max=7.11
+  // with the latencies in milliseconds
+  std::string getSummary() const;
+
+ protected:
+  unsigned int bucketIndex(unsigned long usecs) const;
+  unsigned long bucketValue(unsigned int ix) const;
+
+ private:
+  std::vector<unsigned long> m_counts;
+
+  unsigned long m_count;
+  double        m_total;
+  double        m_min;
+  double        m_max;
+};
+
+#endif
@@ -0,0 +1,339 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: RelaySweep.cpp                                       */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include "MBUtils.h"
+#include "RelaySweep.h"
+
+using namespace std;
+
+//---------------------------------------------------------
+// Procedure: cpuSeconds()
+//   Purpose: User plus system CPU time used by this process
+
+static double cpuSeconds()
+{
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+    return(0);
+  double user = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+  double sys  = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+  return(user + sys);
+}
+
+//---------------------------------------------------------
+// Constructor
+
+RelaySweep::RelaySweep()
+{
+  m_sizes.push_back(64);
+  m_sizes.push_back(1024);
+  m_sizes.push_back(16384);
+  m_rates.push_back(10);
+  m_rates.push_back(100);
+  m_rates.push_back(1000);
+  m_payloads.push_back(false);
+  m_payloads.push_back(true);
+
+  m_step_time  = 10;
+  m_drain_time = 2;
+
+  m_current     = 0;
+  m_started     = false;
+  m_draining    = false;
+  m_step_start  = 0;
+  m_send_end    = 0;
+  m_last_send   = 0;
+  m_send_credit = 0;
+  m_cpu_start   = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: setSizes()
+
+bool RelaySweep::setSizes(string spec)
+{
+  vector<unsigned int> sizes;
+  vector<string> svector = parseString(spec, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string sval = stripBlankEnds(svector[i]);
+    int size = atoi(sval.c_str());
+    if(!isNumber(sval) || (size <= 0))
+      return(false);
+    sizes.push_back(size);
+  }
+  if(sizes.size() == 0)
+    return(false);
+  m_sizes = sizes;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: setRates()
+
+bool RelaySweep::setRates(string spec)
+{
+  vector<double> rates;
+  vector<string> svector = parseString(spec, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string sval = stripBlankEnds(svector[i]);
+    double rate = atof(sval.c_str());
+    if(!isNumber(sval) || (rate <= 0))
+      return(false);
+    rates.push_back(rate);
+  }
+  if(rates.size() == 0)
+    return(false);
+  m_rates = rates;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: setPayloads()
+
+bool RelaySweep::setPayloads(string spec)
+{
+  spec = tolower(stripBlankEnds(spec));
+  m_payloads.clear();
+  if((spec == "string") || (spec == "both"))
+    m_payloads.push_back(false);
+  if((spec == "binary") || (spec == "both"))
+    m_payloads.push_back(true);
+  if(m_payloads.size() > 0)
+    return(true);
+
+  m_payloads.push_back(false);
+  return(false);
+}
+
+//---------------------------------------------------------
+// Procedure: setStepTime()
+
+bool RelaySweep::setStepTime(double secs)
+{
+  if(secs <= 0)
+    return(false);
+  m_step_time = secs;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: setDrainTime()
+
+bool RelaySweep::setDrainTime(double secs)
+{
+  if(secs < 0)
+    return(false);
+  m_drain_time = secs;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: start()
+
+void RelaySweep::start(double now)
+{
+  m_steps.clear();
+  for(unsigned int p=0; p<m_payloads.size(); p++) {
+    for(unsigned int s=0; s<m_sizes.size(); s++) {
+      for(unsigned int r=0; r<m_rates.size(); r++) {
+        Step step;
+        step.binary   = m_payloads[p];
+        step.size     = m_sizes[s];
+        step.rate     = m_rates[r];
+        step.sent     = 0;
+        step.recd     = 0;
+        step.bytes    = 0;
+        step.duration = 0;
+        step.cpu_secs = 0;
+        m_steps.push_back(step);
+      }
+    }
+  }
+
+  m_started = true;
+  m_current = 0;
+  startStep(now);
+}
+
+//---------------------------------------------------------
+// Procedure: startStep()
+
+void RelaySweep::startStep(double now)
+{
+  m_draining    = false;
+  m_step_start  = now;
+  m_send_end    = now;
+  m_last_send   = now;
+  m_send_credit = 0;
+  m_cpu_start   = cpuSeconds();
+}
+
+//---------------------------------------------------------
+// Procedure: endStep()
+//   Purpose: Record the step's results. The duration is the measured
+//            sending time, which runs past step_time by up to one
+//            iteration.
+
+void RelaySweep::endStep()
+{
+  Step& step = m_steps[m_current];
+  step.duration = m_send_end - m_step_start;
+  step.cpu_secs = cpuSeconds() - m_cpu_start;
+}
+
+//---------------------------------------------------------
+// Procedure: update()
+
+bool RelaySweep::update(double now)
+{
+  if(!m_started || finished())
+    return(false);
+
+  double elapsed = now - m_step_start;
+  if(!m_draining && (elapsed >= m_step_time)) {
+    m_draining = true;
+    m_send_end = now;
+  }
+  if(elapsed < m_step_time + m_drain_time)
+    return(false);
+
+  endStep();
+  m_current++;
+  if(!finished())
+    startStep(now);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: sendCount()
+
+unsigned int RelaySweep::sendCount(double now)
+{
+  if(!m_started || finished() || m_draining)
+    return(0);
+
+  m_send_credit += m_steps[m_current].rate * (now - m_last_send);
+  m_last_send = now;
+
+  unsigned int amt = (unsigned int)(m_send_credit);
+  m_send_credit -= amt;
+  return(amt);
+}
+
+//---------------------------------------------------------
+// Procedure: isBinary()
+
+bool RelaySweep::isBinary() const
+{
+  if(m_current >= m_steps.size())
+    return(false);
+  return(m_steps[m_current].binary);
+}
+
+//---------------------------------------------------------
+// Procedure: getSize()
+
+unsigned int RelaySweep::getSize() const
+{
+  if(m_current >= m_steps.size())
+    return(0);
+  return(m_steps[m_current].size);
+}
+
+//---------------------------------------------------------
+// Procedure: noteSent()
+
+void RelaySweep::noteSent(unsigned int bytes)
+{
+  if(m_current >= m_steps.size())
+    return;
+  m_steps[m_current].sent++;
+  m_steps[m_current].bytes += bytes;
+}
+
+//---------------------------------------------------------
+// Procedure: noteEcho()
+
+void RelaySweep::noteEcho(unsigned int step, double rtt)
+{
+  if(step >= m_steps.size())
+    return;
+  m_steps[step].recd++;
+  m_steps[step].rtt.record(rtt);
+}
+
+//---------------------------------------------------------
+// Procedure: getStepSummary()
+
+string RelaySweep::getStepSummary(unsigned int ix) const
+{
+  if(ix >= m_steps.size())
+    return("");
+
+  const Step& step = m_steps[ix];
+  double duration = (step.duration > 0) ? step.duration : m_step_time;
+
+  string summary = "step=" + uintToString(ix);
+  summary += ",payload=" + string(step.binary ? "binary" : "string");
+  summary += ",size=" + uintToString(step.size);
+  summary += ",target_hz=" + doubleToStringX(step.rate);
+  summary += ",achieved_hz=" + doubleToString(step.recd / duration, 1);
+  summary += ",sent=" + uintToString(step.sent);
+  summary += ",recd=" + uintToString(step.recd);
+  summary += ",p50=" + doubleToString(step.rtt.getPercentile(50) * 1000, 2);
+  summary += ",p99=" + doubleToString(step.rtt.getPercentile(99) * 1000, 2);
+  summary += ",cpu=" + doubleToString(step.cpu_secs, 3);
+  return(summary);
+}
+
+//---------------------------------------------------------
+// Procedure: writeCSV()
+
+bool RelaySweep::writeCSV(const string& filename) const
+{
+  FILE* f = fopen(filename.c_str(), "w");
+  if(!f)
+    return(false);
+
+  fprintf(f, "step,payload,size,target_hz,sent,recd,lost,achieved_hz,mbytes_per_sec,");
+  fprintf(f, "rtt_p50_ms,rtt_p90_ms,rtt_p99_ms,rtt_p999_ms,rtt_max_ms,cpu_secs,cpu_pct\n");
+  for(unsigned int i=0; i<m_steps.size(); i++) {
+    const Step& step = m_steps[i];
+    double duration = (step.duration > 0) ? step.duration : m_step_time;
+    unsigned long lost = (step.sent > step.recd) ? step.sent - step.recd : 0;
+    fprintf(f, "%u,%s,%u,%g,%lu,%lu,%lu,%.1f,%.3f,", i,
+            step.binary ? "binary" : "string", step.size, step.rate,
+            step.sent, step.recd, lost, step.recd / duration,
+            step.bytes / duration / 1e6);
+    fprintf(f, "%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f\n",
+            step.rtt.getPercentile(50) * 1000, step.rtt.getPercentile(90) * 1000,
+            step.rtt.getPercentile(99) * 1000, step.rtt.getPercentile(99.9) * 1000,
+            step.rtt.getMax() * 1000, step.cpu_secs,
+            100 * step.cpu_secs / (duration + m_drain_time));
+  }
+  fclose(f);
+  return(true);
+}
@@ -0,0 +1,109 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: RelaySweep.h                                         */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+#ifndef RELAY_SWEEP_HEADER
+#define RELAY_SWEEP_HEADER
+
+#include <string>
+#include <vector>
+#include "LatencyHistogram.h"
+
+// The schedule and results of a payload size and rate sweep. Every
+// combination of payload type (string or binary), size and target
+// rate is run for a fixed time, followed by a short drain in which
+// nothing is sent so the last echoes of the step can come back. Echoes
+// carry their step number, so late arrivals are not credited to the
+// next step. The app drives the timing and does the posting.
+
+class RelaySweep
+{
+ public:
+  RelaySweep();
+  ~RelaySweep() {};
+
+  bool setSizes(std::string spec);
+  bool setRates(std::string spec);
+  bool setPayloads(std::string spec);
+  bool setStepTime(double secs);
+  bool setDrainTime(double secs);
+
+  // Build the steps and start the first one
+  void start(double now);
+  bool started() const   {return(m_started);};
+  bool finished() const  {return(m_started && (m_current >= m_steps.size()));};
+
+  // Advance to the next step when due. Returns true on a step change.
+  bool update(double now);
+
+  // Messages to send this iteration to hold the target rate, zero
+  // during the drain
+  unsigned int sendCount(double now);
+
+  unsigned int getStepIndex() const  {return(m_current);};
+  bool isBinary() const;
+  unsigned int getSize() const;
+
+  void noteSent(unsigned int bytes);
+  void noteEcho(unsigned int step, double rtt);
+
+  // step=3,payload=binary,size=4096,target_hz=100,achieved_hz=99.6,...
+  std::string getStepSummary(unsigned int step) const;
+  unsigned int sizeSteps() const  {return(m_steps.size());};
+
+  bool writeCSV(const std::string& filename) const;
+
+ protected:
+  void startStep(double now);
+  void endStep();
+
+  struct Step {
+    bool         binary;
+    unsigned int size;
+    double       rate;
+
+    unsigned long sent;
+    unsigned long recd;
+    double        bytes;
+    double        duration;   // measured sending time
+    double        cpu_secs;
+    LatencyHistogram rtt;
+  };
+
+ private:
+  std::vector<unsigned int> m_sizes;
+  std::vector<double>       m_rates;
+  std::vector<bool>         m_payloads;   // true for binary
+  double m_step_time;
+  double m_drain_time;
+
+  std::vector<Step> m_steps;
+  unsigned int m_current;
+  bool   m_started;
+  bool   m_draining;
+  double m_step_start;
+  double m_send_end;      // when the current step stopped sending
+  double m_last_send;
+  double m_send_credit;
+  double m_cpu_start;
+};
+
+#endif
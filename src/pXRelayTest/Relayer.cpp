@@ -21,6 +21,10 @@
 /*****************************************************************/
 
 #include <iterator>
+#include <vector>
+#include <map>
+#include <cctype>
+#include <cstdlib>
 #include "Relayer.h"
 #include "MBUtils.h"
  
@@ -38,6 +42,22 @@ Relayer::Relayer()
 
   m_start_time_postings   = 0;
   m_start_time_iterations = 0;
+
+  m_mode = "relay";
+  m_bench_burst = 1;
+  m_bench_report_interval = 5;
+  m_bench_last_report = 0;
+
+  m_bench_sent = 0;
+  m_bench_recd = 0;
+  m_forward_in_mail = false;
+
+  m_sweep_file = "xrelay_sweep.csv";
+  m_sweep_done = false;
+
+  m_batch = false;
+  m_max_batch = 100;
+  m_posts = 0;
 }
 
 //---------------------------------------------------------
@@ -51,8 +71,37 @@ bool Relayer::OnNewMail(MOOSMSG_LIST &NewMail)
     
     string key = msg.GetKey();
 
-    if(key == m_incoming_var) 
+    if(!isIncoming(key))
+      continue;
+
+    // A batched relay post carries the number of messages it stands for
+    if(m_mode == "relay") {
+      double count = 1;
+      if(msg.IsString())
+        tokParse(msg.GetString(), "count", ',', '=', count);
+      m_tally_recd += (unsigned long int)(count);
+      continue;
+    }
+
+    // Binary probes carry a text header, a zero byte and padding
+    if(msg.IsBinary()) {
       m_tally_recd++;
+      handleBinary(msg);
+      continue;
+    }
+
+    // Benchmark posts may hold several probes separated by ';'
+    string source = msg.GetSource();
+    vector<string> items = parseString(msg.GetString(), ';');
+    for(unsigned int i=0; i<items.size(); i++) {
+      m_tally_recd++;
+      if(m_mode == "echo")
+        handleProbe(items[i], source);
+      else if(m_mode == "forward")
+        handleForward(items[i], source, 0);
+      else
+        handleEcho(items[i], source);
+    }
   }
   return(true);
 }
@@ -73,8 +122,28 @@ bool Relayer::OnConnectToServer()
 
 void Relayer::RegisterVariables()
 {
-  if(m_incoming_var != "")
-    Register(m_incoming_var, 0);
+  // A comma separated list lets one relayer merge several branches
+  m_incoming_vars.clear();
+  vector<string> svector = parseString(m_incoming_var, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string var = stripBlankEnds(svector[i]);
+    if(var != "") {
+      m_incoming_vars.push_back(var);
+      Register(var, 0);
+    }
+  }
+}
+
+//------------------------------------------------------------
+// Procedure: isIncoming()
+
+bool Relayer::isIncoming(const string& key) const
+{
+  for(unsigned int i=0; i<m_incoming_vars.size(); i++) {
+    if(key == m_incoming_vars[i])
+      return(true);
+  }
+  return(false);
 }
 
 
@@ -85,10 +154,33 @@ bool Relayer::Iterate()
 {
   m_iterations++;
 
-  unsigned int i, amt = (m_tally_recd - m_tally_sent);
-  for(i=0; i<amt; i++) {
-    m_tally_sent++;
-    Notify(m_outgoing_var, m_tally_sent);
+  unsigned int amt = 0;
+  if(m_mode == "origin")
+    amt = sendProbes();
+  else if(m_mode == "sweep")
+    amt = sendSweep();
+  else if((m_mode == "echo") || (m_mode == "forward"))
+    amt = relayEchoes();
+  else if(m_batch) {
+    // Relay the backlog as few posts as max_batch allows
+    amt = (m_tally_recd - m_tally_sent);
+    for(unsigned int i=0; i<amt; i+=m_max_batch) {
+      unsigned int count = amt - i;
+      if(count > m_max_batch)
+        count = m_max_batch;
+      m_tally_sent += count;
+      m_posts++;
+      Notify(m_outgoing_var, "count=" + uintToString(count) +
+             ",last=" + uintToString(m_tally_sent));
+    }
+  }
+  else {
+    amt = (m_tally_recd - m_tally_sent);
+    for(unsigned int i=0; i<amt; i++) {
+      m_tally_sent++;
+      m_posts++;
+      Notify(m_outgoing_var, m_tally_sent);
+    }
   }
   
   // If this is the first iteration just note the start time, otherwise
@@ -111,11 +203,374 @@ bool Relayer::Iterate()
       double delta_time = (MOOSTime() - m_start_time_postings) + 0.01;
       double frequency = (double)(m_tally_sent) / delta_time;
       Notify(m_outgoing_var+"_POST_HZ", frequency);
+      // Posts actually made to the DB, fewer than the above if batching
+      Notify(m_outgoing_var+"_NOTIFY_HZ", (double)(m_posts) / delta_time);
     }
   }
+
+  if(m_mode != "relay")
+    postBenchmark();
   return(true);
 }
 
+//---------------------------------------------------------
+// Procedure: sendProbes()
+//   Purpose: In origin mode, post bench_burst probes, each carrying
+//            a sequence number and its send time.
+
+unsigned int Relayer::sendProbes()
+{
+  vector<string> probes;
+  for(unsigned int i=0; i<m_bench_burst; i++) {
+    m_bench_sent++;
+    string probe = "seq=" + uintToString(m_bench_sent);
+    probe += ",t0=" + doubleToString(MOOSTime(), 6);
+    probes.push_back(probe);
+  }
+  postItems(probes);
+  return(probes.size());
+}
+
+//---------------------------------------------------------
+// Procedure: postItems()
+//   Purpose: Post one item per Notify, or with batch=true up to
+//            max_batch items per Notify separated by ';'.
+
+void Relayer::postItems(const vector<string>& items)
+{
+  m_tally_sent += items.size();
+  if(!m_batch) {
+    for(unsigned int i=0; i<items.size(); i++) {
+      m_posts++;
+      Notify(m_outgoing_var, items[i]);
+    }
+    return;
+  }
+
+  for(unsigned int i=0; i<items.size(); i+=m_max_batch) {
+    string batch = items[i];
+    for(unsigned int j=i+1; (j<items.size()) && (j<i+m_max_batch); j++)
+      batch += ";" + items[j];
+    m_posts++;
+    Notify(m_outgoing_var, batch);
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: sendSweep()
+//   Purpose: In sweep mode, send probes of the current step's payload
+//            type and size at its target rate. Each step's results are
+//            posted as it ends, and the CSV is written after the last.
+
+unsigned int Relayer::sendSweep()
+{
+  double now = MOOSTime();
+  if(!m_sweep.started())
+    m_sweep.start(now);
+
+  if(m_sweep.update(now))
+    Notify(m_outgoing_var+"_SWEEP_STEP", m_sweep.getStepSummary(m_sweep.getStepIndex()-1));
+
+  if(m_sweep.finished()) {
+    if(!m_sweep_done) {
+      m_sweep_done = true;
+      if(m_sweep.writeCSV(m_sweep_file))
+        Notify(m_outgoing_var+"_SWEEP_DONE", m_sweep_file);
+      else
+        Notify(m_outgoing_var+"_SWEEP_DONE", "error: unable to write " + m_sweep_file);
+    }
+    return(0);
+  }
+
+  unsigned int amt  = m_sweep.sendCount(now);
+  unsigned int size = m_sweep.getSize();
+  string step = ",step=" + uintToString(m_sweep.getStepIndex());
+
+  vector<string> probes;
+  for(unsigned int i=0; i<amt; i++) {
+    m_bench_sent++;
+    string header = "seq=" + uintToString(m_bench_sent);
+    header += ",t0=" + doubleToString(MOOSTime(), 6) + step;
+
+    if(m_sweep.isBinary()) {
+      m_tally_sent++;
+      m_posts++;
+      vector<unsigned char> probe = binaryPayload(header, size);
+      Notify(m_outgoing_var, probe);
+      m_sweep.noteSent(probe.size());
+    }
+    else {
+      if(header.size() + 5 < size)
+        header += ",pad=" + string(size - header.size() - 5, 'x');
+      m_sweep.noteSent(header.size());
+      probes.push_back(header);
+    }
+  }
+  postItems(probes);
+  return(amt);
+}
+
+//---------------------------------------------------------
+// Procedure: binaryPayload()
+//   Purpose: A text header, a zero byte, then padding up to size
+
+vector<unsigned char> Relayer::binaryPayload(const string& header,
+                                             unsigned int size) const
+{
+  vector<unsigned char> payload(header.begin(), header.end());
+  payload.push_back(0);
+  if(payload.size() < size)
+    payload.resize(size, 0xA5);
+  return(payload);
+}
+
+//---------------------------------------------------------
+// Procedure: handleBinary()
+//   Purpose: The echo sends a binary probe back as binary of the same
+//            size with its stamps added to the header. The origin
+//            reads only the header.
+
+void Relayer::handleBinary(const CMOOSMsg& msg)
+{
+  const unsigned char* data = msg.GetBinaryData();
+  unsigned int size = msg.GetBinaryDataSize();
+
+  unsigned int len = 0;
+  while((len < size) && (data[len] != 0))
+    len++;
+  string header((const char*)(data), len);
+
+  if(m_mode == "echo") {
+    unsigned int queued = m_echo_queue.size();
+    handleProbe(header, msg.GetSource());
+    if(m_echo_queue.size() > queued) {
+      m_echo_binary.push_back(m_echo_queue.back());
+      m_echo_sizes.push_back(size);
+      m_echo_queue.pop_back();
+    }
+  }
+  else if(m_mode == "forward")
+    handleForward(header, msg.GetSource(), size);
+  else
+    handleEcho(header, msg.GetSource());
+}
+
+//---------------------------------------------------------
+// Procedure: hopStamps()
+//   Purpose: The arrival times h1=..,h2=.. added by each forwarder
+//            along the way, in hop order.
+
+static vector<double> hopStamps(const string& probe)
+{
+  vector<double> stamps;
+  vector<string> svector = parseString(probe, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    const string& field = svector[i];
+    if((field.size() < 4) || (field[0] != 'h') || !isdigit(field[1]))
+      continue;
+    string hop = biteString(svector[i], '=');
+    unsigned int ix = atoi(hop.c_str() + 1);
+    if(ix == 0)
+      continue;
+    if(stamps.size() < ix)
+      stamps.resize(ix, 0);
+    stamps[ix-1] = atof(svector[i].c_str());
+  }
+  return(stamps);
+}
+
+//---------------------------------------------------------
+// Procedure: handleForward()
+//   Purpose: In forward mode, stamp the probe with this hop's number
+//            and arrival time and pass it on, either straight from
+//            here (forward_in_mail) or on the next iteration. A
+//            binary probe (size > 0) goes on as binary of that size.
+
+void Relayer::handleForward(const string& probe, const string& source,
+                            unsigned int size)
+{
+  double now = MOOSTime();
+
+  double seq = 0, t0 = 0;
+  if(!tokParse(probe, "seq", ',', '=', seq) || !tokParse(probe, "t0", ',', '=', t0))
+    return;
+  noteSequence(source, (unsigned long)(seq));
+  m_hist_out.record(now - t0);
+
+  unsigned int hop = hopStamps(probe).size() + 1;
+  string stamped = probe + ",h" + uintToString(hop) + "=" + doubleToString(now, 6);
+
+  if(m_forward_in_mail) {
+    m_tally_sent++;
+    m_posts++;
+    if(size > 0)
+      Notify(m_outgoing_var, binaryPayload(stamped, size));
+    else
+      Notify(m_outgoing_var, stamped);
+  }
+  else if(size > 0) {
+    m_echo_binary.push_back(stamped);
+    m_echo_sizes.push_back(size);
+  }
+  else
+    m_echo_queue.push_back(stamped);
+}
+
+//---------------------------------------------------------
+// Procedure: handleProbe()
+//   Purpose: In echo mode, note the one-way latency of the probe and
+//            queue it to go back with the time it arrived.
+
+void Relayer::handleProbe(const string& probe, const string& source)
+{
+  double now = MOOSTime();
+
+  double seq = 0, t0 = 0;
+  if(!tokParse(probe, "seq", ',', '=', seq) || !tokParse(probe, "t0", ',', '=', t0))
+    return;
+
+  noteSequence(source, (unsigned long)(seq));
+  m_hist_out.record(now - t0);
+  m_echo_queue.push_back(probe + ",t1=" + doubleToString(now, 6));
+}
+
+//---------------------------------------------------------
+// Procedure: relayEchoes()
+//   Purpose: In echo mode, send back the probes received since the
+//            last iteration, stamped with the time they left. The
+//            gap from t1 to t2 is the wait for this app's tick.
+//            In forward mode, pass them on as they are.
+
+unsigned int Relayer::relayEchoes()
+{
+  unsigned int amt = m_echo_queue.size();
+  string t2;
+  if(m_mode == "echo")
+    t2 = ",t2=" + doubleToString(MOOSTime(), 6);
+  for(unsigned int i=0; i<amt; i++)
+    m_echo_queue[i] += t2;
+  postItems(m_echo_queue);
+  m_echo_queue.clear();
+
+  for(unsigned int i=0; i<m_echo_binary.size(); i++) {
+    m_tally_sent++;
+    m_posts++;
+    Notify(m_outgoing_var, binaryPayload(m_echo_binary[i] + t2, m_echo_sizes[i]));
+  }
+  amt += m_echo_binary.size();
+  m_echo_binary.clear();
+  m_echo_sizes.clear();
+  return(amt);
+}
+
+//---------------------------------------------------------
+// Procedure: handleEcho()
+//   Purpose: In origin mode, a probe has come back. All times are
+//            MOOSTime on the same host, so one-way latencies in each
+//            direction can be taken from the stamps. A probe that came
+//            round a chain of forwarders also has the latency of each
+//            hop, the last hop being the one back to here.
+
+void Relayer::handleEcho(const string& echo, const string& source)
+{
+  double now = MOOSTime();
+
+  double seq = 0, t0 = 0, t1 = 0, t2 = 0;
+  if(!tokParse(echo, "seq", ',', '=', seq) || !tokParse(echo, "t0", ',', '=', t0))
+    return;
+
+  noteSequence(source, (unsigned long)(seq));
+  m_hist_rtt.record(now - t0);
+  if(tokParse(echo, "t1", ',', '=', t1) && tokParse(echo, "t2", ',', '=', t2)) {
+    m_hist_out.record(t1 - t0);
+    m_hist_back.record(now - t2);
+  }
+
+  vector<double> stamps = hopStamps(echo);
+  if(stamps.size() > 0) {
+    if(m_hist_hops.size() < stamps.size() + 1)
+      m_hist_hops.resize(stamps.size() + 1);
+    double prev = t0;
+    for(unsigned int i=0; i<stamps.size(); i++) {
+      m_hist_hops[i].record(stamps[i] - prev);
+      prev = stamps[i];
+    }
+    m_hist_hops[stamps.size()].record(now - prev);
+  }
+
+  double step = 0;
+  if((m_mode == "sweep") && tokParse(echo, "step", ',', '=', step))
+    m_sweep.noteEcho((unsigned int)(step), now - t0);
+}
+
+//---------------------------------------------------------
+// Procedure: noteSequence()
+//   Purpose: Anything arriving below the highest sequence number
+//            seen so far from the same source arrived out of order.
+//            Sources are kept apart so that copies of a probe coming
+//            back along several branches are not counted as reordered.
+
+void Relayer::noteSequence(const string& source, unsigned long seq)
+{
+  m_bench_recd++;
+
+  SeqTally& tally = m_seq_tallies[source];
+  tally.recd++;
+  if(seq > tally.highest)
+    tally.highest = seq;
+  else
+    tally.reordered++;
+}
+
+//---------------------------------------------------------
+// Procedure: postBenchmark()
+//   Purpose: Post the latency percentiles (in ms) and loss counts
+//            every bench_report_interval seconds. Missing counts
+//            sequence numbers below the highest not yet received.
+
+void Relayer::postBenchmark()
+{
+  double now = MOOSTime();
+  if((now - m_bench_last_report) < m_bench_report_interval)
+    return;
+  m_bench_last_report = now;
+
+  unsigned long int missing = 0;
+  unsigned long int reordered = 0;
+  string branches;
+  map<string, SeqTally>::const_iterator p;
+  for(p=m_seq_tallies.begin(); p!=m_seq_tallies.end(); p++) {
+    if(p->second.highest > p->second.recd)
+      missing += p->second.highest - p->second.recd;
+    reordered += p->second.reordered;
+    if(branches != "")
+      branches += ",";
+    branches += p->first + "=" + uintToString(p->second.recd);
+  }
+
+  string loss;
+  if((m_mode != "echo") && (m_mode != "forward"))
+    loss = "sent=" + uintToString(m_bench_sent) + ",";
+  loss += "recd=" + uintToString(m_bench_recd);
+  loss += ",missing=" + uintToString(missing);
+  loss += ",reordered=" + uintToString(reordered);
+  Notify(m_outgoing_var+"_LOSS", loss);
+  if(m_seq_tallies.size() > 1)
+    Notify(m_outgoing_var+"_BRANCHES", branches);
+
+  for(unsigned int i=0; i<m_hist_hops.size(); i++)
+    Notify(m_outgoing_var+"_HOP"+uintToString(i+1), m_hist_hops[i].getSummary());
+
+  bool passive = ((m_mode == "echo") || (m_mode == "forward"));
+  if(!passive) {
+    Notify(m_outgoing_var+"_RTT", m_hist_rtt.getSummary());
+    Notify(m_outgoing_var+"_OWD_OUT", m_hist_out.getSummary());
+    Notify(m_outgoing_var+"_OWD_BACK", m_hist_back.getSummary());
+  }
+  else
+    Notify(m_outgoing_var+"_OWD_IN", m_hist_out.getSummary());
+}
+
 
 
 //---------------------------------------------------------
@@ -138,6 +593,41 @@ bool Relayer::OnStartUp()
     
     else if(param == "outgoing_var")
       m_outgoing_var = value;
+
+    else if(param == "mode") {
+      value = tolower(value);
+      if((value == "relay") || (value == "origin") || (value == "echo") ||
+         (value == "sweep") || (value == "forward"))
+        m_mode = value;
+    }
+    else if(param == "bench_burst") {
+      unsigned int burst = 0;
+      if(setUIntOnString(burst, value) && (burst > 0))
+        m_bench_burst = burst;
+    }
+    else if(param == "batch")
+      setBooleanOnString(m_batch, value);
+    else if(param == "max_batch") {
+      unsigned int max_batch = 0;
+      if(setUIntOnString(max_batch, value) && (max_batch > 0))
+        m_max_batch = max_batch;
+    }
+    else if(param == "forward_in_mail")
+      setBooleanOnString(m_forward_in_mail, value);
+    else if(param == "sweep_sizes")
+      m_sweep.setSizes(value);
+    else if(param == "sweep_rates")
+      m_sweep.setRates(value);
+    else if(param == "sweep_payloads")
+      m_sweep.setPayloads(value);
+    else if(param == "sweep_step_time")
+      m_sweep.setStepTime(atof(value.c_str()));
+    else if(param == "sweep_drain_time")
+      m_sweep.setDrainTime(atof(value.c_str()));
+    else if(param == "sweep_file")
+      m_sweep_file = value;
+    else if(param == "bench_report_interval")
+      setPosDoubleOnString(m_bench_report_interval, value);
   }
 
   RegisterVariables();
@@ -23,7 +23,11 @@
 #ifndef P_RELAY_VAR_HEADER
 #define P_RELAY_VAR_HEADER
 
+#include <vector>
+#include <map>
 #include "MOOS/libMOOS/MOOSLib.h"
+#include "LatencyHistogram.h"
+#include "RelaySweep.h"
 
 class Relayer : public CMOOSApp
 {
@@ -40,16 +44,69 @@ class Relayer : public CMOOSApp
   void setIncomingVar(std::string s) {m_incoming_var=s;};
   void setOutgoingVar(std::string s) {m_outgoing_var=s;};
 
+ protected:
+  unsigned int sendProbes();
+  unsigned int relayEchoes();
+  unsigned int sendSweep();
+  void handleBinary(const CMOOSMsg& msg);
+  std::vector<unsigned char> binaryPayload(const std::string& header,
+                                           unsigned int size) const;
+  void postItems(const std::vector<std::string>& items);
+  void handleProbe(const std::string& probe, const std::string& source);
+  void handleEcho(const std::string& echo, const std::string& source);
+  void handleForward(const std::string& probe, const std::string& source,
+                     unsigned int size);
+  void noteSequence(const std::string& source, unsigned long seq);
+  bool isIncoming(const std::string& key) const;
+  void postBenchmark();
+
  protected:
   unsigned long int m_tally_recd;
   unsigned long int m_tally_sent;
   unsigned long int m_iterations;
 
-  std::string       m_incoming_var;
+  std::string       m_incoming_var;    // may be a comma separated list
+  std::vector<std::string> m_incoming_vars;
   std::string       m_outgoing_var;
 
   double            m_start_time_postings;
   double            m_start_time_iterations;
+
+  bool              m_batch;         // aggregate the backlog per Notify
+  unsigned int      m_max_batch;
+  unsigned long int m_posts;         // Notify calls for OUTGOING_VAR
+
+ protected: // Benchmark mode
+  std::string       m_mode;          // relay, origin, echo, sweep or forward
+  unsigned int      m_bench_burst;   // probes sent per iteration
+  double            m_bench_report_interval;
+  double            m_bench_last_report;
+
+  unsigned long int m_bench_sent;
+  unsigned long int m_bench_recd;
+  bool              m_forward_in_mail;
+
+  struct SeqTally {
+    SeqTally() : highest(0), recd(0), reordered(0) {};
+    unsigned long int highest;
+    unsigned long int recd;
+    unsigned long int reordered;
+  };
+  std::map<std::string, SeqTally> m_seq_tallies;   // keyed on source
+
+  std::vector<std::string> m_echo_queue;
+  std::vector<std::string> m_echo_binary;   // headers of binary probes
+  std::vector<unsigned int> m_echo_sizes;   // and their payload sizes
+
+  LatencyHistogram  m_hist_rtt;      // origin: probe out and back
+  LatencyHistogram  m_hist_out;      // origin to echo
+  LatencyHistogram  m_hist_back;     // echo back to origin
+  std::vector<LatencyHistogram> m_hist_hops;   // per hop of a chain
+
+ protected: // Sweep mode
+  RelaySweep        m_sweep;
+  std::string       m_sweep_file;
+  bool              m_sweep_done;
 };
 
 #endif 
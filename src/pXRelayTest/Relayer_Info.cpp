@@ -92,6 +92,37 @@ void showExampleConfigAndExit()
   blk("                                                                ");
   blk("  OUTGOING_VAR = APPLES                                         ");
   blk("  INCOMING_VAR = PEARS                                          ");
+  blk("                                                                ");
+  blk("  // relay (default) counts and relays mail. For a latency      ");
+  blk("  // benchmark run one app as origin and one as echo, each      ");
+  blk("  // with the other's OUTGOING_VAR as its INCOMING_VAR.         ");
+  blk("  mode                  = relay   // or origin, echo, sweep,    ");
+  blk("                                  // forward                    ");
+  blk("  bench_burst           = 1       // origin probes per tick     ");
+  blk("  bench_report_interval = 5       // seconds                    ");
+  blk("                                                                ");
+  blk("  // Forward mode passes probes on, stamped with the hop number ");
+  blk("  // and arrival time, to build chains and fan-out/fan-in back  ");
+  blk("  // to an origin. INCOMING_VAR may list several variables.     ");
+  blk("  // With forward_in_mail = true probes are passed on as they   ");
+  blk("  // arrive rather than on the next iteration.                  ");
+  blk("  forward_in_mail       = false   // default                    ");
+  blk("                                                                ");
+  blk("  // Relay the backlog in as few posts as possible, up to        ");
+  blk("  // max_batch messages per post, in any mode.                  ");
+  blk("  batch                 = false   // default                    ");
+  blk("  max_batch             = 100     // default                    ");
+  blk("                                                                ");
+  blk("  // Sweep mode is origin mode stepping through every payload   ");
+  blk("  // type, size (bytes) and target rate (Hz), each for          ");
+  blk("  // sweep_step_time secs plus sweep_drain_time secs to collect ");
+  blk("  // late echoes. Results go to sweep_file as CSV at the end.   ");
+  blk("  sweep_payloads        = both    // string, binary or both     ");
+  blk("  sweep_sizes           = 64,1024,16384                         ");
+  blk("  sweep_rates           = 10,100,1000                           ");
+  blk("  sweep_step_time       = 10                                    ");
+  blk("  sweep_drain_time      = 2                                     ");
+  blk("  sweep_file            = xrelay_sweep.csv                      ");
   blk("}                                                               ");
   blk("                                                                ");
   exit(0);
@@ -112,7 +143,7 @@ void showInterfaceAndExit()
   blk("                                                                ");
   blk("SUBSCRIPTIONS:                                                  ");
   blk("------------------------------------                            ");
-  blk("  Whatever variable is specified by the INCOMING_VAR            ");
+  blk("  Whatever variable(s) are specified by the INCOMING_VAR         ");
   blk("  configuration parameter.                                      ");
   blk("                                                                ");
   blk("PUBLICATIONS:                                                   ");
@@ -120,6 +151,33 @@ void showInterfaceAndExit()
   blk("  Whatever variable is specified by the OUTGOING_VAR            ");
   blk("  configuration parameter.                                      ");
   blk("                                                                ");
+  blk("  <OUTGOING_VAR>_ITER_HZ = Iterations per second.               ");
+  blk("  <OUTGOING_VAR>_POST_HZ = Messages relayed per second.         ");
+  blk("  <OUTGOING_VAR>_NOTIFY_HZ = Posts of OUTGOING_VAR per second,  ");
+  blk("                           fewer than the above if batching.    ");
+  blk("  With batch = true in relay mode OUTGOING_VAR is posted as     ");
+  blk("  count=12,last=340, and in origin/echo mode as up to max_batch ");
+  blk("  probes separated by ';'.                                      ");
+  blk("                                                                ");
+  blk("  In origin or echo mode, latencies in ms as                    ");
+  blk("  n=1200,min=0.41,p50=0.98,p90=1.60,p99=2.84,p99.9=6.02,max=7.1 ");
+  blk("  <OUTGOING_VAR>_RTT      = Origin: probe round trip.           ");
+  blk("  <OUTGOING_VAR>_OWD_OUT  = Origin: origin to echo.             ");
+  blk("  <OUTGOING_VAR>_OWD_BACK = Origin: echo back to origin.        ");
+  blk("  <OUTGOING_VAR>_OWD_IN   = Echo or forward: origin to here.    ");
+  blk("  <OUTGOING_VAR>_HOP<N>   = Origin: latency of hop N of a chain,");
+  blk("                            the last being the hop back.        ");
+  blk("  <OUTGOING_VAR>_BRANCHES = Probes received per source when more");
+  blk("                            than one, e.g. under fan-in.        ");
+  blk("  <OUTGOING_VAR>_LOSS     = sent=400,recd=398,missing=1,        ");
+  blk("                            reordered=0                         ");
+  blk("                                                                ");
+  blk("  In sweep mode also:                                           ");
+  blk("  <OUTGOING_VAR>_SWEEP_STEP = step=3,payload=binary,size=1024,  ");
+  blk("                    target_hz=100,achieved_hz=99.6,sent=1000,   ");
+  blk("                    recd=996,p50=1.02,p99=3.40,cpu=0.210        ");
+  blk("  <OUTGOING_VAR>_SWEEP_DONE = Name of the CSV file written.     ");
+  blk("                                                                ");
   exit(0);
 }
 
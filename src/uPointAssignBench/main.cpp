@@ -0,0 +1,319 @@
+/************************************************************/
+/*    NAME: Adam Cohen                                      */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: main.cpp                                        */
+/*    DATE: March 13, 2025                                  */
+/************************************************************/
+
+// Load test for the pPointAssign solvers. Generates fields like the
+// lab_08 uTimerScript (x in [-25,200], y in [-175,-25]) at increasing
+// scale, runs each assignment mode on them without a MOOSDB, and
+// prints the assignment time, the nearest-neighbour tour each vehicle
+// would fly, how evenly the work is spread and what delivering the
+// result would cost in VISIT_POINT messages.
+//
+//   uPointAssignBench --scale=50:50000 --modes=cluster,auction
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "MBUtils.h"
+#include "AssignUtils.h"
+#include "PointAuction.h"
+#include "PointStore.h"
+#include "PointBatch.h"
+
+using namespace std;
+
+struct Scale {
+  unsigned int vehicles;
+  unsigned int points;
+};
+
+// The modes assignByMode() knows, and the default run order
+const string all_modes = "alternating,region,cluster,balance,auction,stream";
+
+//---------------------------------------------------------
+// Procedure: makeField()
+//   Purpose: Random points fed through the same ingest path as the
+//            app, so parsing is part of what gets exercised.
+
+PointStore makeField(unsigned int amt)
+{
+  PointStore store;
+  for(unsigned int i=0; i<amt; i++) {
+    double x = -25  + (225.0 * rand() / RAND_MAX);
+    double y = -175 + (150.0 * rand() / RAND_MAX);
+    string spec = "x=" + doubleToStringX(x, 2) + ", y=" + doubleToStringX(y, 2);
+    spec += ", id=" + uintToString(i+1);
+    unsigned int ix;
+    store.add(spec, 0, ix);
+  }
+  return(store);
+}
+
+//---------------------------------------------------------
+// Procedure: makeStarts()
+//   Purpose: Vehicles spread along the shore north of the field.
+
+vector<AssignPt> makeStarts(unsigned int amt)
+{
+  vector<AssignPt> starts(amt);
+  for(unsigned int v=0; v<amt; v++) {
+    starts[v].x = -25 + 225.0 * (v + 0.5) / amt;
+    starts[v].y = 0;
+  }
+  return(starts);
+}
+
+//---------------------------------------------------------
+// Procedure: nearestNeighborLength()
+//   Purpose: Length of the greedy path pGenPath builds from start.
+
+double nearestNeighborLength(const vector<AssignPt>& pts, AssignPt start,
+                             vector<unsigned int> members)
+{
+  double total = 0;
+  while(!members.empty()) {
+    unsigned int best = 0;
+    double best_dist = -1;
+    for(unsigned int j=0; j<members.size(); j++) {
+      double dist = distPts(start, pts[members[j]]);
+      if((best_dist < 0) || (dist < best_dist)) {
+        best = j;
+        best_dist = dist;
+      }
+    }
+    total += best_dist;
+    start = pts[members[best]];
+    members[best] = members.back();
+    members.pop_back();
+  }
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: assignByMode()
+//   Purpose: The vehicle index of each point under the given mode,
+//            mirroring what PointAssign does for that mode.
+
+vector<unsigned int> assignByMode(const string& mode,
+                                  const vector<AssignPt>& pts,
+                                  const vector<AssignPt>& starts,
+                                  unsigned int window)
+{
+  unsigned int n = pts.size();
+  unsigned int k = starts.size();
+  vector<unsigned int> labels(n, 0);
+
+  if(mode == "alternating") {
+    for(unsigned int i=0; i<n; i++)
+      labels[i] = i % k;
+  }
+  else if(mode == "region") {
+    for(unsigned int i=0; i<n; i++)
+      labels[i] = ((pts[i].x < 87.5) || (k < 2)) ? 0 : 1;
+  }
+  else if(mode == "cluster")
+    labels = assignByCluster(pts, starts);
+  else if(mode == "balance") {
+    vector<vector<unsigned int> > tours;
+    vector<double> lens;
+    labels = assignByTourBalance(pts, starts, 200, tours, lens);
+  }
+  else if(mode == "auction") {
+    PointAuction auction;
+    auction.setVehicleCount(k);
+    for(unsigned int v=0; v<k; v++)
+      auction.setVehiclePos(v, starts[v].x, starts[v].y);
+    for(unsigned int i=0; i<n; i++)
+      auction.addPoint(pts[i].x, pts[i].y);
+    auction.runRound(0);
+    for(unsigned int i=0; i<n; i++)
+      labels[i] = auction.getOwner(i);
+  }
+  else if(mode == "stream") {
+    vector<vector<unsigned int> > tours(k);
+    vector<double> lens(k, 0);
+    for(unsigned int i=0; i<n; i+=window) {
+      vector<unsigned int> ixs;
+      for(unsigned int j=i; (j<n) && (j<i+window); j++)
+        ixs.push_back(j);
+      insertByTourBalance(pts, starts, ixs, tours, lens);
+    }
+    for(unsigned int v=0; v<k; v++) {
+      for(unsigned int j=0; j<tours[v].size(); j++)
+        labels[tours[v][j]] = v;
+    }
+  }
+  return(labels);
+}
+
+//---------------------------------------------------------
+// Procedure: runScale()
+
+void runScale(const Scale& scale, const vector<string>& modes,
+              unsigned int batch_size, unsigned int window)
+{
+  PointStore store = makeField(scale.points);
+  vector<AssignPt> pts(store.size());
+  for(unsigned int i=0; i<store.size(); i++)
+    pts[i] = store.at(i).pos;
+  vector<AssignPt> starts = makeStarts(scale.vehicles);
+  unsigned int k = starts.size();
+
+  printf("\n== %u vehicles, %u points ==\n", scale.vehicles, scale.points);
+  printf("%-12s %10s %9s %9s %9s %8s %7s %7s %7s %7s %9s %9s\n",
+         "mode", "assign_ms", "tour_max", "tour_avg", "tour_min", "max/avg",
+         "pts_min", "pts_max", "msgs", "batched", "kb", "kb_batch");
+
+  for(unsigned int m=0; m<modes.size(); m++) {
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    vector<unsigned int> labels = assignByMode(modes[m], pts, starts, window);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    double ms = chrono::duration<double, milli>(t1 - t0).count();
+
+    vector<vector<unsigned int> > members(k);
+    for(unsigned int i=0; i<labels.size(); i++)
+      members[labels[i]].push_back(i);
+
+    // Each vehicle gets firstpoint and lastpoint plus its points,
+    // either one message each or batch_size to a message
+    double tour_max = 0, tour_min = -1, tour_sum = 0;
+    unsigned int pts_min = scale.points, pts_max = 0;
+    unsigned int msgs = 0, msgs_batched = 0;
+    double bytes = 0, bytes_batched = 0;
+    for(unsigned int v=0; v<k; v++) {
+      double len = nearestNeighborLength(pts, starts[v], members[v]);
+      tour_sum += len;
+      if(len > tour_max)
+        tour_max = len;
+      if((tour_min < 0) || (len < tour_min))
+        tour_min = len;
+      if(members[v].size() < pts_min)
+        pts_min = members[v].size();
+      if(members[v].size() > pts_max)
+        pts_max = members[v].size();
+
+      msgs += members[v].size() + 2;
+      msgs_batched += 2;
+      bytes += string("firstpoint").length() + string("lastpoint").length();
+      bytes_batched += string("firstpoint").length() + string("lastpoint").length();
+      vector<string> chunk;
+      for(unsigned int j=0; j<members[v].size(); j++) {
+        const string& spec = store.at(members[v][j]).spec;
+        bytes += spec.length();
+        chunk.push_back(spec);
+        if((chunk.size() == batch_size) || (j+1 == members[v].size())) {
+          bytes_batched += buildPointBatch(msgs_batched, chunk).length();
+          msgs_batched++;
+          chunk.clear();
+        }
+      }
+    }
+    double tour_avg = tour_sum / k;
+
+    printf("%-12s %10.1f %9.0f %9.0f %9.0f %8.2f %7u %7u %7u %7u %9.1f %9.1f\n",
+           modes[m].c_str(), ms, tour_max, tour_avg, tour_min,
+           (tour_avg > 0) ? tour_max / tour_avg : 0, pts_min, pts_max,
+           msgs, msgs_batched, bytes / 1024, bytes_batched / 1024);
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: showHelp()
+
+void showHelp()
+{
+  cout << "Usage: uPointAssignBench [OPTIONS]                          " << endl;
+  cout << "                                                            " << endl;
+  cout << "  --scale=<vehicles>:<points>  Add a field size to run.     " << endl;
+  cout << "                               May be repeated. Default is  " << endl;
+  cout << "                               2:100 10:1000 50:10000       " << endl;
+  cout << "                               50:50000                     " << endl;
+  cout << "  --modes=<m1,m2,..>           Default is alternating,region," << endl;
+  cout << "                               cluster,balance,auction,stream" << endl;
+  cout << "  --batch=<n>                  Points per batched message   " << endl;
+  cout << "                               (default 50)                 " << endl;
+  cout << "  --window=<n>                 Stream mode window (default 20)" << endl;
+  cout << "  --seed=<n>                   Random seed (default 1)      " << endl;
+}
+
+//---------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  vector<Scale>  scales;
+  vector<string> modes;
+  unsigned int batch_size = 50;
+  unsigned int window = 20;
+  unsigned int seed = 1;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if((argi == "-h") || (argi == "--help")) {
+      showHelp();
+      return(0);
+    }
+    else if(strBegins(argi, "--scale=")) {
+      string val = argi.substr(8);
+      string vehicles = biteStringX(val, ':');
+      Scale scale;
+      scale.vehicles = atoi(vehicles.c_str());
+      scale.points   = atoi(val.c_str());
+      if((scale.vehicles == 0) || (scale.points == 0)) {
+        cout << "Bad scale: " << argi << endl;
+        return(1);
+      }
+      scales.push_back(scale);
+    }
+    else if(strBegins(argi, "--modes=")) {
+      modes = parseString(argi.substr(8), ',');
+      vector<string> known = parseString(all_modes, ',');
+      for(unsigned int j=0; j<modes.size(); j++) {
+        if(!vectorContains(known, modes[j])) {
+          cout << "Unknown mode: " << modes[j] << endl;
+          showHelp();
+          return(1);
+        }
+      }
+    }
+    else if(strBegins(argi, "--batch="))
+      batch_size = atoi(argi.substr(8).c_str());
+    else if(strBegins(argi, "--window="))
+      window = atoi(argi.substr(9).c_str());
+    else if(strBegins(argi, "--seed="))
+      seed = atoi(argi.substr(7).c_str());
+    else {
+      cout << "Unhandled argument: " << argi << endl;
+      showHelp();
+      return(1);
+    }
+  }
+
+  if(scales.empty()) {
+    unsigned int ladder[4][2] = {{2,100}, {10,1000}, {50,10000}, {50,50000}};
+    for(unsigned int i=0; i<4; i++) {
+      Scale scale;
+      scale.vehicles = ladder[i][0];
+      scale.points   = ladder[i][1];
+      scales.push_back(scale);
+    }
+  }
+  if(modes.empty())
+    modes = parseString(all_modes, ',');
+  if(batch_size == 0)
+    batch_size = 1;
+  if(window == 0)
+    window = 1;
+
+  for(unsigned int i=0; i<scales.size(); i++) {
+    srand(seed);
+    runScale(scales[i], modes, batch_size, window);
+  }
+  return(0);
+}
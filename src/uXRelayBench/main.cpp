@@ -0,0 +1,349 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: main.cpp                                             */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This program is free software; you can redistribute it and/or */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation; either version  */
+/* 2 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* This program is distributed in the hope that it will be       */
+/* useful, but WITHOUT ANY WARRANTY; without even the implied    */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the GNU General Public License for more details. */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with this program; if not, write to the Free    */
+/* Software Foundation, Inc., 59 Temple Place - Suite 330,       */
+/* Boston, MA 02111-1307, USA.                                   */
+/*****************************************************************/
+
+// Runs pXRelayTest and pOdometry on the in-process fake MOOSDB from
+// lib_fakemoos rather than a live one. Every app ticks on a shared
+// virtual clock, so the latencies, loss and distances the apps post
+// are the same run to run, and the wall time they spend in OnNewMail
+// and Iterate is measured apart from the time the bus spends routing
+// their posts. Scenarios mirror the missions in missions/xrelay:
+//
+//   pair      ORIGIN/ECHO and the batched BORIGIN/BECHO pair
+//   chain     an origin and --hops forwarders in a line
+//   fan       an origin and three forwarders fanning back in
+//   odometry  a simulated vehicle circling at --speed for pOdometry
+//
+//   uXRelayBench --scenario=pair --secs=60 --burst=50 --check
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "MBUtils.h"
+#include "FakeMOOSBus.h"
+#include "Relayer.h"
+#include "Odometry.h"
+
+using namespace std;
+
+struct BenchOpts {
+  string       scenario;
+  double       secs;
+  double       app_tick;
+  double       latency;
+  unsigned int burst;
+  unsigned int hops;
+  double       speed;
+  bool         appcast;
+  bool         check;
+};
+
+//---------------------------------------------------------
+// SimNav: circles at a fixed speed posting NAV_X/Y/DEPTH, standing
+// in for uSimMarine in the odometry scenario
+
+class SimNav : public CMOOSApp
+{
+ public:
+  SimNav(double speed) {m_speed=speed; m_start_time=0;};
+  virtual ~SimNav() {};
+
+  bool OnStartUp()
+  {
+    m_start_time = MOOSTime();
+    return(true);
+  }
+
+  bool Iterate()
+  {
+    double radius = 50;
+    double angle  = m_speed * (MOOSTime() - m_start_time) / radius;
+    Notify("NAV_X", radius * cos(angle));
+    Notify("NAV_Y", radius * sin(angle));
+    Notify("NAV_DEPTH", 10 + 5 * sin(angle / 4));
+    return(true);
+  }
+
+ protected:
+  double m_speed;
+  double m_start_time;
+};
+
+//---------------------------------------------------------
+// Procedure: makeConfig()
+//   Purpose: Config lines from a '#' separated list, the same lines
+//            a ProcessConfig block would give the app.
+
+STRING_LIST makeConfig(const string& spec)
+{
+  STRING_LIST config;
+  vector<string> svector = parseString(spec, '#');
+  for(unsigned int i=0; i<svector.size(); i++)
+    config.push_back(stripBlankEnds(svector[i]));
+  return(config);
+}
+
+//---------------------------------------------------------
+// Procedure: addRelayer()
+
+void addRelayer(FakeMOOSBus& bus, vector<CMOOSApp*>& apps, const string& name,
+                double app_tick, const string& spec)
+{
+  Relayer* relayer = new Relayer;
+  apps.push_back(relayer);
+  if(!bus.addApp(relayer, name, app_tick, makeConfig(spec)))
+    cout << "Failed to start " << name << endl;
+}
+
+//---------------------------------------------------------
+// Procedure: buildScenario()
+//   Purpose: Add the scenario's apps to the bus and return the
+//            variables holding its results.
+
+vector<string> buildScenario(FakeMOOSBus& bus, vector<CMOOSApp*>& apps,
+                             const BenchOpts& opts)
+{
+  vector<string> results;
+  string burst = uintToString(opts.burst);
+  double tick  = opts.app_tick;
+
+  if(opts.scenario == "pair") {
+    addRelayer(bus, apps, "pXRelay_ORIGIN", tick,
+               "outgoing_var=PROBE # incoming_var=ECHO # mode=origin #"
+               "bench_burst=" + burst + " # bench_report_interval=5");
+    addRelayer(bus, apps, "pXRelay_ECHO", tick,
+               "outgoing_var=ECHO # incoming_var=PROBE # mode=echo");
+    addRelayer(bus, apps, "pXRelay_BORIGIN", tick,
+               "outgoing_var=BPROBE # incoming_var=BECHO # mode=origin #"
+               "bench_burst=" + burst + " # bench_report_interval=5 #"
+               "batch=true # max_batch=100");
+    addRelayer(bus, apps, "pXRelay_BECHO", tick,
+               "outgoing_var=BECHO # incoming_var=BPROBE # mode=echo #"
+               "batch=true # max_batch=100");
+    results = parseString("PROBE_RTT,PROBE_LOSS,PROBE_NOTIFY_HZ,"
+                          "BPROBE_RTT,BPROBE_LOSS,BPROBE_NOTIFY_HZ", ',');
+  }
+  else if(opts.scenario == "chain") {
+    string last = "CHAIN" + uintToString(opts.hops);
+    addRelayer(bus, apps, "pXRelay_CHAIN_ORIGIN", tick,
+               "outgoing_var=CHAIN0 # incoming_var=" + last + " # mode=origin #"
+               "bench_burst=" + burst + " # bench_report_interval=5");
+    for(unsigned int i=1; i<=opts.hops; i++) {
+      string in  = "CHAIN" + uintToString(i-1);
+      string out = "CHAIN" + uintToString(i);
+      addRelayer(bus, apps, "pXRelay_F" + uintToString(i), tick,
+                 "outgoing_var=" + out + " # incoming_var=" + in + " # mode=forward");
+    }
+    results.push_back("CHAIN0_RTT");
+    for(unsigned int i=1; i<=opts.hops+1; i++)
+      results.push_back("CHAIN0_HOP" + uintToString(i));
+    results.push_back("CHAIN0_LOSS");
+  }
+  else if(opts.scenario == "fan") {
+    addRelayer(bus, apps, "pXRelay_FAN_ORIGIN", tick,
+               "outgoing_var=FAN # incoming_var=FAN_A,FAN_B,FAN_C # mode=origin #"
+               "bench_burst=" + burst + " # bench_report_interval=5");
+    addRelayer(bus, apps, "pXRelay_FA", tick,
+               "outgoing_var=FAN_A # incoming_var=FAN # mode=forward");
+    addRelayer(bus, apps, "pXRelay_FB", tick,
+               "outgoing_var=FAN_B # incoming_var=FAN # mode=forward");
+    addRelayer(bus, apps, "pXRelay_FC", tick,
+               "outgoing_var=FAN_C # incoming_var=FAN # mode=forward");
+    results = parseString("FAN_RTT,FAN_LOSS,FAN_BRANCHES", ',');
+  }
+  else if(opts.scenario == "odometry") {
+    SimNav* nav = new SimNav(opts.speed);
+    apps.push_back(nav);
+    bus.addApp(nav, "uSimMarine", tick);
+
+    Odometry* odometry = new Odometry;
+    apps.push_back(odometry);
+    bus.addApp(odometry, "pOdometry", 4,
+               makeConfig("depth_thresh=12 # stats_windows=10,60 #"
+                          "depth_bands=8,12 # stats_interval=5"));
+    results = parseString("ODOMETRY_DIST,ODOMETRY_DIST_AT_DEPTH,"
+                          "ODOMETRY_WINDOW,ODOMETRY_DEPTH_BANDS", ',');
+  }
+  return(results);
+}
+
+//---------------------------------------------------------
+// Procedure: latestValue()
+
+string latestValue(const FakeMOOSBus& bus, const string& var)
+{
+  CMOOSMsg msg;
+  if(!bus.getLatest(var, msg))
+    return("n/a");
+  if(msg.IsDouble())
+    return(doubleToStringX(msg.GetDouble(), 4));
+  return(msg.GetString());
+}
+
+//---------------------------------------------------------
+// Procedure: printStats()
+
+void printStats(const FakeMOOSBus& bus)
+{
+  printf("%-22s %7s %9s %9s %11s %9s %11s %11s\n", "app", "ticks",
+         "mail_in", "posts", "ns/mail_msg", "us/iter", "ns/post_bus", "app/bus");
+
+  double app_total = 0;
+  double bus_total = 0;
+  for(unsigned int i=0; i<bus.size(); i++) {
+    FakeMOOSBus::AppStats stats = bus.getStats(i);
+    double app_ns = stats.mail_ns + stats.iterate_ns;
+    app_total += app_ns;
+    bus_total += stats.bus_ns;
+    printf("%-22s %7lu %9lu %9lu %11.1f %9.2f %11.1f %11.2f\n",
+           bus.getAppName(i).c_str(), stats.ticks, stats.mail_msgs, stats.posts,
+           stats.mail_msgs ? stats.mail_ns / stats.mail_msgs : 0,
+           stats.ticks ? stats.iterate_ns / stats.ticks / 1000 : 0,
+           stats.posts ? stats.bus_ns / stats.posts : 0,
+           (stats.bus_ns > 0) ? app_ns / stats.bus_ns : 0);
+  }
+  printf("app time %.2f ms, bus time %.2f ms, %lu messages delivered\n",
+         app_total / 1e6, bus_total / 1e6, bus.getDelivered());
+}
+
+//---------------------------------------------------------
+// Procedure: runScenario()
+//   Purpose: One run of the scenario. Returns the result variables
+//            so repeated runs can be compared.
+
+string runScenario(const BenchOpts& opts, bool verbose)
+{
+  FakeMOOSBus bus;
+  bus.setLatency(opts.latency);
+
+  vector<CMOOSApp*> apps;
+  vector<string> results = buildScenario(bus, apps, opts);
+  if(opts.appcast)
+    bus.poke("APPCAST_REQ", "app=any,duration=" + doubleToStringX(opts.secs + 1));
+
+  bus.run(opts.secs);
+
+  string summary;
+  for(unsigned int i=0; i<results.size(); i++)
+    summary += results[i] + " = " + latestValue(bus, results[i]) + "\n";
+
+  if(verbose) {
+    printf("== %s: %.0f virtual secs, AppTick %g, latency %g ==\n",
+           opts.scenario.c_str(), opts.secs, opts.app_tick, opts.latency);
+    printStats(bus);
+    printf("\n%s", summary.c_str());
+  }
+
+  for(unsigned int i=0; i<apps.size(); i++)
+    delete(apps[i]);
+  return(summary);
+}
+
+//---------------------------------------------------------
+// Procedure: showHelp()
+
+void showHelp()
+{
+  cout << "Usage: uXRelayBench [OPTIONS]                               " << endl;
+  cout << "                                                            " << endl;
+  cout << "  --scenario=<s>     pair, chain, fan or odometry (pair)      " << endl;
+  cout << "  --secs=<n>         Virtual seconds to run (60)              " << endl;
+  cout << "  --tick=<hz>        AppTick of the relay apps (20)           " << endl;
+  cout << "  --latency=<secs>   Virtual delay of each post (0)           " << endl;
+  cout << "  --burst=<n>        Probes per origin iteration (50)         " << endl;
+  cout << "  --hops=<n>         Forwarders in the chain scenario (3)     " << endl;
+  cout << "  --speed=<m/s>      Vehicle speed, odometry scenario (2)     " << endl;
+  cout << "  --appcast          Keep an APPCAST_REQ in force throughout  " << endl;
+  cout << "  --check            Run twice and confirm identical results  " << endl;
+}
+
+//---------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  BenchOpts opts;
+  opts.scenario = "pair";
+  opts.secs     = 60;
+  opts.app_tick = 20;
+  opts.latency  = 0;
+  opts.burst    = 50;
+  opts.hops     = 3;
+  opts.speed    = 2;
+  opts.appcast  = false;
+  opts.check    = false;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if((argi == "-h") || (argi == "--help")) {
+      showHelp();
+      return(0);
+    }
+    else if(strBegins(argi, "--scenario="))
+      opts.scenario = tolower(argi.substr(11));
+    else if(strBegins(argi, "--secs="))
+      opts.secs = atof(argi.substr(7).c_str());
+    else if(strBegins(argi, "--tick="))
+      opts.app_tick = atof(argi.substr(7).c_str());
+    else if(strBegins(argi, "--latency="))
+      opts.latency = atof(argi.substr(10).c_str());
+    else if(strBegins(argi, "--burst="))
+      opts.burst = atoi(argi.substr(8).c_str());
+    else if(strBegins(argi, "--hops="))
+      opts.hops = atoi(argi.substr(7).c_str());
+    else if(strBegins(argi, "--speed="))
+      opts.speed = atof(argi.substr(8).c_str());
+    else if(argi == "--appcast")
+      opts.appcast = true;
+    else if(argi == "--check")
+      opts.check = true;
+    else {
+      cout << "Unhandled argument: " << argi << endl;
+      showHelp();
+      return(1);
+    }
+  }
+
+  if((opts.scenario != "pair") && (opts.scenario != "chain") &&
+     (opts.scenario != "fan") && (opts.scenario != "odometry")) {
+    cout << "Unknown scenario: " << opts.scenario << endl;
+    return(1);
+  }
+  if((opts.secs <= 0) || (opts.app_tick <= 0)) {
+    cout << "secs and tick must be positive" << endl;
+    return(1);
+  }
+  if(opts.hops == 0)
+    opts.hops = 1;
+
+  string first = runScenario(opts, true);
+  if(opts.check) {
+    string second = runScenario(opts, false);
+    bool same = (first == second);
+    printf("\nrepeat run: %s\n", same ? "identical results" : "RESULTS DIFFER");
+    if(!same)
+      return(1);
+  }
+  return(0);
+}